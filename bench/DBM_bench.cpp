@@ -0,0 +1,218 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "bench_util.h"
+#include "pardibaal/closure.h"
+#include "pardibaal/fixed_kernels.h"
+
+using namespace pardibaal;
+using namespace pardibaal::bench;
+
+// Dimensions include the zero clock
+static void dimensions(benchmark::internal::Benchmark* b) {
+    b->ArgName("dim")->RangeMultiplier(2)->Range(2, 128);
+}
+
+// The bounds of a zone where the upper bound of the last clock has been loosened
+static std::vector<bound_t> loosened_bounds(dim_t dim) {
+    const DBM base = random_zone(dim, 1);
+    std::vector<bound_t> bounds(dim * dim);
+    for (dim_t i = 0; i < dim; ++i)
+        for (dim_t j = 0; j < dim; ++j)
+            bounds[i * dim + j] = base.at(i, j);
+    bounds[(dim - 1) * dim] = bound_t::inf();
+    return bounds;
+}
+
+// Full closure, as done by DBM::close() after bounds of more than one clock were set. Includes the copy of the bounds.
+static void BM_DBM_close(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const std::vector<bound_t> base = loosened_bounds(dim);
+    std::vector<bound_t> bounds(base.size());
+
+    for (auto _ : state) {
+        std::copy(base.begin(), base.end(), bounds.begin());
+        benchmark::DoNotOptimize(close_bounds(bounds.data(), dim));
+    }
+}
+BENCHMARK(BM_DBM_close)->Apply(dimensions)->Arg(256)->Arg(512);
+
+// As BM_DBM_close with closure threads enabled
+static void BM_DBM_close_parallel(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const std::vector<bound_t> base = loosened_bounds(dim);
+    std::vector<bound_t> bounds(base.size());
+    set_closure_threads(state.range(1));
+
+    for (auto _ : state) {
+        std::copy(base.begin(), base.end(), bounds.begin());
+        benchmark::DoNotOptimize(close_bounds(bounds.data(), dim));
+    }
+    set_closure_threads(1);
+}
+BENCHMARK(BM_DBM_close_parallel)->ArgNames({"dim", "threads"})->ArgsProduct({{128, 256, 512}, {2, 4, 8}})->UseRealTime();
+
+// Full closure of small DBMs with the fixed-dimension kernel, and with the generic row kernel (which
+// close_bounds_parallel runs on a single thread). close_bounds uses the fixed kernel up to fixed::MAX_CLOSE_DIMENSION.
+template<bool is_fixed>
+static void BM_DBM_close_small(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const std::vector<bound_t> base = loosened_bounds(dim);
+    std::vector<bound_t> bounds(base.size());
+
+    for (auto _ : state) {
+        std::copy(base.begin(), base.end(), bounds.begin());
+        if constexpr (is_fixed) {
+            fixed::dispatch_fixed<fixed::MAX_DIMENSION>(dim, [&bounds]<dim_t N>(std::integral_constant<dim_t, N>) {
+                benchmark::DoNotOptimize(fixed::close<N>(bounds.data()));
+            });
+        } else {
+            benchmark::DoNotOptimize(close_bounds_parallel(bounds.data(), dim, 1));
+        }
+    }
+}
+BENCHMARK_TEMPLATE(BM_DBM_close_small, true)->ArgName("dim")->DenseRange(2, fixed::MAX_DIMENSION);
+BENCHMARK_TEMPLATE(BM_DBM_close_small, false)->ArgName("dim")->DenseRange(2, fixed::MAX_DIMENSION);
+
+// Closure after loosening a single bound, which only re-closes the row and column of that clock.
+// Includes the copy of the zone.
+static void BM_DBM_close_clock(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const DBM base = random_zone(dim, 1);
+
+    for (auto _ : state) {
+        DBM D = base;
+        D.set(dim - 1, 0, bound_t::inf());
+        D.close();
+        benchmark::DoNotOptimize(D.at(0, 0));
+    }
+}
+BENCHMARK(BM_DBM_close_clock)->Apply(dimensions)->Arg(256)->Arg(512);
+
+// Restrict with a guard of five constraints. Includes the copy of the zone.
+static void BM_DBM_restrict(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const DBM base = random_zone(dim, 1);
+    std::vector<difference_bound_t> guard;
+    for (dim_t i = 0; i < 5; ++i) {
+        dim_t x = 1 + (i * 7) % (dim - 1);
+        guard.push_back(difference_bound_t::upper_non_strict(x, base.at(x, 0).get_bound() - 1));
+    }
+
+    for (auto _ : state) {
+        DBM D = base;
+        D.restrict(guard);
+        benchmark::DoNotOptimize(D.is_empty());
+    }
+}
+BENCHMARK(BM_DBM_restrict)->Apply(dimensions);
+
+// Relation between a zone and a slightly larger one, which must compare all bounds
+static void BM_DBM_relation(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const DBM D = random_zone(dim, 1);
+    DBM Q = D;
+    Q.future();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(D.relation(Q));
+}
+BENCHMARK(BM_DBM_relation)->Apply(dimensions);
+
+// A fresh copy each iteration, so the hash is computed rather than read from the cache
+static void BM_DBM_hash(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const DBM base = random_zone(dim, 1);
+
+    for (auto _ : state) {
+        DBM D = base;
+        benchmark::DoNotOptimize(D.hash());
+    }
+}
+BENCHMARK(BM_DBM_hash)->Apply(dimensions);
+
+// Includes the copy of the zone
+static void BM_DBM_extrapolate_lu_diagonal(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const DBM base = random_zone(dim, 1);
+    const auto lower = random_bounds(dim, 2), upper = random_bounds(dim, 3);
+
+    for (auto _ : state) {
+        DBM D = base;
+        D.extrapolate_lu_diagonal(lower, upper);
+        benchmark::DoNotOptimize(D.at(0, 0));
+    }
+}
+BENCHMARK(BM_DBM_extrapolate_lu_diagonal)->Apply(dimensions);
+
+// Includes the copy of the zone
+static void BM_DBM_extrapolate_lu_diagonal_context(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const DBM base = random_zone(dim, 1);
+    const auto extrapolation = extrapolation_t::lu_diagonal(random_bounds(dim, 2), random_bounds(dim, 3));
+
+    for (auto _ : state) {
+        DBM D = base;
+        D.extrapolate(extrapolation);
+        benchmark::DoNotOptimize(D.at(0, 0));
+    }
+}
+BENCHMARK(BM_DBM_extrapolate_lu_diagonal_context)->Apply(dimensions);
+
+// Subsumption modulo LU bounds by extrapolating a copy of the stored zone and comparing
+static void BM_DBM_extrapolated_subset(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const DBM zone = random_zone(dim, 1), stored = random_zone(dim, 2);
+    const auto lower = random_bounds(dim, 2), upper = random_bounds(dim, 3);
+
+    for (auto _ : state) {
+        DBM D = stored;
+        D.extrapolate_lu_diagonal(lower, upper);
+        benchmark::DoNotOptimize(zone.is_subset(D));
+    }
+}
+BENCHMARK(BM_DBM_extrapolated_subset)->Apply(dimensions);
+
+static void BM_DBM_is_included_lu(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const DBM zone = random_zone(dim, 1), stored = random_zone(dim, 2);
+    const auto lower = random_bounds(dim, 2), upper = random_bounds(dim, 3);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(zone.is_included_lu(stored, lower, upper));
+}
+BENCHMARK(BM_DBM_is_included_lu)->Apply(dimensions);
+
+// Includes the copy of the zone
+static void BM_DBM_intersection(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const DBM base = random_zone(dim, 1), other = random_zone(dim, 2);
+
+    for (auto _ : state) {
+        DBM D = base;
+        D.intersection(other);
+        benchmark::DoNotOptimize(D.is_empty());
+    }
+}
+BENCHMARK(BM_DBM_intersection)->Apply(dimensions);
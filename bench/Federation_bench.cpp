@@ -0,0 +1,171 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "bench_util.h"
+
+using namespace pardibaal;
+using namespace pardibaal::bench;
+
+// Dimension (including the zero clock) and number of zones
+static void dimensions_and_sizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"dim", "zones"})->ArgsProduct({{2, 4, 8, 16, 32, 64, 128}, {1, 4, 16, 64, 256}});
+}
+
+// Subtraction closes the zone once per constraint of the subtrahend, so large zones only run on few zones
+static void subtract_dimensions_and_sizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"dim", "zones"})->ArgsProduct({{2, 4, 8, 16, 32}, {1, 4, 16, 64, 256}})
+            ->ArgsProduct({{64, 128}, {1, 4}});
+}
+
+// Reducing, merging, limiting and covering are at least quadratic in the number of zones,
+// so they run on smaller federations
+static void small_dimensions_and_sizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"dim", "zones"})->ArgsProduct({{2, 4, 8, 16}, {1, 4, 16}});
+}
+
+// Includes the copy of the federation
+static void BM_Federation_subtract(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const Federation base = random_federation(dim, state.range(1), 1);
+    const DBM dbm = random_zone(dim, 1000);
+
+    for (auto _ : state) {
+        Federation fed = base;
+        fed.subtract(dbm);
+        benchmark::DoNotOptimize(fed.size());
+    }
+    state.counters["result_zones"] = [&] {Federation fed = base; fed.subtract(dbm); return fed.size();}();
+}
+BENCHMARK(BM_Federation_subtract)->Apply(subtract_dimensions_and_sizes);
+
+static void BM_Federation_subtract_disjoint(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const Federation base = random_federation(dim, state.range(1), 1);
+    const DBM dbm = random_zone(dim, 1000);
+
+    for (auto _ : state) {
+        Federation fed = base;
+        fed.subtract_disjoint(dbm);
+        benchmark::DoNotOptimize(fed.size());
+    }
+    state.counters["result_zones"] = [&] {Federation fed = base; fed.subtract_disjoint(dbm); return fed.size();}();
+}
+BENCHMARK(BM_Federation_subtract_disjoint)->Apply(subtract_dimensions_and_sizes);
+
+// Reduces the fragments of subtracting a zone from each zone of the federation
+static void BM_Federation_reduce(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    Federation base = random_federation(dim, state.range(1), 1);
+    base.subtract(random_zone(dim, 1000));
+
+    for (auto _ : state) {
+        Federation fed = base;
+        fed.reduce();
+        benchmark::DoNotOptimize(fed.size());
+    }
+    state.counters["zones"] = base.size();
+    state.counters["result_zones"] = [&] {Federation fed = base; fed.reduce(); return fed.size();}();
+}
+BENCHMARK(BM_Federation_reduce)->Apply(small_dimensions_and_sizes);
+
+static void BM_Federation_merge(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    Federation base = random_federation(dim, state.range(1), 1);
+    base.subtract(random_zone(dim, 1000));
+
+    for (auto _ : state) {
+        Federation fed = base;
+        fed.merge();
+        benchmark::DoNotOptimize(fed.size());
+    }
+    state.counters["zones"] = base.size();
+    state.counters["result_zones"] = [&] {Federation fed = base; fed.merge(); return fed.size();}();
+}
+BENCHMARK(BM_Federation_merge)->Apply(small_dimensions_and_sizes);
+
+// Adds the zones one by one to an empty federation
+static void BM_Federation_add(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const Federation zones = random_federation(dim, state.range(1), 1);
+
+    for (auto _ : state) {
+        Federation fed;
+        fed.add(zones);
+        benchmark::DoNotOptimize(fed.size());
+    }
+}
+BENCHMARK(BM_Federation_add)->Apply(dimensions_and_sizes);
+
+// Adds the zones one by one to an empty federation of at most 4 zones
+static void BM_Federation_add_max_size(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const Federation zones = random_federation(dim, state.range(1), 1);
+
+    for (auto _ : state) {
+        Federation fed;
+        fed.set_max_size(4);
+        fed.add(zones);
+        benchmark::DoNotOptimize(fed.size());
+    }
+}
+BENCHMARK(BM_Federation_add_max_size)->Apply(small_dimensions_and_sizes);
+
+static void BM_Federation_relation_exact(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const Federation fed1 = random_federation(dim, state.range(1), 1);
+    const Federation fed2 = random_federation(dim, state.range(1), 500);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(fed1.relation<true>(fed2));
+}
+BENCHMARK(BM_Federation_relation_exact)->Apply(dimensions_and_sizes);
+
+// A zone covered by the fragments of itself outside delayed copies of it, and those copies
+static void BM_DBM_is_exact_subset_covered(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const DBM dbm = random_zone(dim, 1);
+    Federation fed(dbm);
+    for (dim_t i = 0; i < (dim_t) state.range(1); ++i) {
+        DBM delayed = dbm;
+        delayed.delay(i + 1);
+        fed.subtract(delayed);
+        fed.add(delayed);
+    }
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(dbm.is_exact_subset(fed));
+    state.counters["zones"] = fed.size();
+}
+BENCHMARK(BM_DBM_is_exact_subset_covered)->Apply(small_dimensions_and_sizes);
+
+// A zone not covered by a random federation
+static void BM_DBM_is_exact_subset_uncovered(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    const Federation fed = random_federation(dim, state.range(1), 1);
+    const DBM dbm = random_zone(dim, 500);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(dbm.is_exact_subset(fed));
+}
+BENCHMARK(BM_DBM_is_exact_subset_uncovered)->Apply(small_dimensions_and_sizes);
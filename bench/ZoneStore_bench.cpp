@@ -0,0 +1,62 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "bench_util.h"
+#include "pardibaal/ZoneStore.h"
+
+using namespace pardibaal;
+using namespace pardibaal::bench;
+
+// Dimension (including the zero clock) and number of zones stored for the key
+static void dimensions_and_sizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"dim", "zones"})->ArgsProduct({{4, 16, 64}, {1, 16, 256}});
+}
+
+// Looking up a zone that is already stored, the common case when exploring a state space
+static void BM_ZoneStore_insert_duplicate(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    ZoneStore store;
+    for (uint32_t n = 0; n < state.range(1); ++n)
+        store.insert(0, random_zone(dim, n));
+    const DBM zone = store.zones(0).back();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(store.insert(0, zone));
+    state.counters["stored_zones"] = store.size();
+}
+BENCHMARK(BM_ZoneStore_insert_duplicate)->Apply(dimensions_and_sizes);
+
+// Looking up a zone that is not covered, which must be compared with every stored zone
+static void BM_ZoneStore_is_covered(benchmark::State& state) {
+    const dim_t dim = state.range(0);
+    ZoneStore store;
+    for (uint32_t n = 0; n < state.range(1); ++n)
+        store.insert(0, random_zone(dim, n));
+    const DBM zone = random_zone(dim, 1000);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(store.is_covered(0, zone));
+    state.counters["stored_zones"] = store.size();
+}
+BENCHMARK(BM_ZoneStore_is_covered)->Apply(dimensions_and_sizes);
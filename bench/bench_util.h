@@ -0,0 +1,81 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARDIBAAL_BENCH_UTIL_H
+#define PARDIBAAL_BENCH_UTIL_H
+
+#include <random>
+#include <vector>
+
+#include "pardibaal/DBM.h"
+#include "pardibaal/Federation.h"
+
+namespace pardibaal::bench {
+
+    /**
+     * A random closed, non-empty zone: a box around a random valuation with some diagonal constraints.
+     * The same seed always gives the same zone.
+     */
+    inline DBM random_zone(dim_t dimension, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<val_t> value(0, 100), slack(1, 20);
+        std::bernoulli_distribution coin(0.5);
+
+        std::vector<val_t> v(dimension, 0);
+        for (dim_t i = 1; i < dimension; ++i)
+            v[i] = value(gen);
+
+        std::vector<difference_bound_t> constraints;
+        for (dim_t i = 1; i < dimension; ++i) {
+            constraints.push_back(difference_bound_t::upper_non_strict(i, v[i] + slack(gen)));
+            constraints.push_back(difference_bound_t::lower_non_strict(i, std::max(0, v[i] - slack(gen))));
+            dim_t j = 1 + gen() % (dimension - 1);
+            if (i != j && coin(gen))
+                constraints.emplace_back(i, j, bound_t(v[i] - v[j] + slack(gen), coin(gen)));
+        }
+
+        DBM dbm = DBM::unconstrained(dimension);
+        dbm.restrict(constraints);
+        dbm.close();
+        return dbm;
+    }
+
+    /** A federation of size random zones, which may overlap */
+    inline Federation random_federation(dim_t dimension, dim_t size, uint32_t seed) {
+        Federation fed;
+        for (dim_t i = 0; i < size; ++i)
+            fed.add(random_zone(dimension, seed + i));
+        return fed;
+    }
+
+    /** LU bounds around the constants used by random_zone */
+    inline std::vector<val_t> random_bounds(dim_t dimension, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<val_t> value(10, 110);
+        std::vector<val_t> bounds(dimension, 0);
+        for (dim_t i = 1; i < dimension; ++i)
+            bounds[i] = value(gen);
+        return bounds;
+    }
+}
+
+#endif //PARDIBAAL_BENCH_UTIL_H
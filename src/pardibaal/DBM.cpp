@@ -22,6 +22,10 @@
 
 #include "bound_t.h"
 #include "DBM.h"
+#include "closure.h"
+#include "compare.h"
+#include "hash.h"
+#include "fixed_kernels.h"
 #include "Federation.h"
 #include "errors.h"
 
@@ -38,12 +42,23 @@ namespace pardibaal {
     bool relation_t::is_superset() const {return _is_superset;}
     bool relation_t::is_different() const {return _is_different;}
 
-    DBM::DBM(dim_t number_of_clocks) : _bounds_table(number_of_clocks) {}
+    DBM::DBM(dim_t number_of_clocks, const allocator_type& alloc) : _bounds_table(number_of_clocks, alloc) {}
 
-    DBM DBM::zero(dim_t dimension) {return DBM(dimension);}
+    DBM::DBM(bound_t* bounds, dim_t number_of_clocks, bool is_closed)
+        : _bounds_table(bounds, number_of_clocks), _empty_status(UNKNOWN), _is_closed(is_closed) {}
 
-    DBM DBM::unconstrained(dim_t dimension) {
-        DBM dbm(dimension);
+    DBM::DBM(const DBM& dbm, const allocator_type& alloc)
+        : _bounds_table(dbm._bounds_table, alloc), _empty_status(dbm._empty_status), _is_closed(dbm._is_closed),
+          _dirty_clock(dbm._dirty_clock), _is_lazy(dbm._is_lazy) {}
+
+    DBM::DBM(DBM&& dbm, const allocator_type& alloc)
+        : _bounds_table(std::move(dbm._bounds_table), alloc), _empty_status(dbm._empty_status), _is_closed(dbm._is_closed),
+          _dirty_clock(dbm._dirty_clock), _is_lazy(dbm._is_lazy) {}
+
+    DBM DBM::zero(dim_t dimension, const allocator_type& alloc) {return DBM(dimension, alloc);}
+
+    DBM DBM::unconstrained(dim_t dimension, const allocator_type& alloc) {
+        DBM dbm(dimension, alloc);
 
         for (dim_t i = 1; i < dimension; ++i)
             dbm.free(i);
@@ -51,6 +66,7 @@ namespace pardibaal {
     }
 
     void DBM::subtract(dim_t i, dim_t j, bound_t bound) {
+        canonicalize();
         if (this->at(i, j) > bound) // if i,j,bound is larger than current, then result is empty. Always false if bound is inf
             this->restrict(j, i, bound_t(-bound.get_bound(), bound.is_non_strict()));
         else
@@ -63,21 +79,38 @@ namespace pardibaal {
 
     dim_t DBM::dimension() const {return this->_bounds_table.number_of_clocks();}
 
+    DBM::allocator_type DBM::get_allocator() const {return this->_bounds_table.get_allocator();}
+
     bool DBM::is_empty() const {
-        // Check if 0 - 0 is less than 0 (used for quicker identification of empty zone
+        // Known after closure, and after operations that find an inconsistent constraint
         if (_empty_status != UNKNOWN)
             return _empty_status == EMPTY ? true : false;
 
-        // The DBM has to be closed for this to actually work
-        for (dim_t i = 0; i < this->dimension(); ++i) {
-            for (dim_t j = 0; j < this->dimension(); ++j) {
-                bound_t i_to_j_to_i = this->_bounds_table.at(i, j) + this->_bounds_table.at(j, i);
+        if (not _is_closed && _is_lazy) {
+            canonicalize();
+            return _empty_status == EMPTY;
+        }
 
-                if (i_to_j_to_i < bound_t::le_zero()) {
-                    _empty_status = EMPTY;
-                    return true;
+        // Not closed and not lazy: a cycle of two bounds as stored, which is only exact once the DBM is closed
+        if (not _is_closed) {
+            for (dim_t i = 0; i < this->dimension(); ++i) {
+                for (dim_t j = 0; j < this->dimension(); ++j) {
+                    if (this->_bounds_table.at(i, j) + this->_bounds_table.at(j, i) < bound_t::le_zero()) {
+                        _empty_status = EMPTY;
+                        return true;
+                    }
                 }
             }
+            _empty_status = NON_EMPTY;
+            return false;
+        }
+
+        // Closed, but not by this DBM (eg. a view). In a closed DBM, i to j to i is never tighter than i to i.
+        for (dim_t i = 0; i < this->dimension(); ++i) {
+            if (this->_bounds_table.at(i, i) < bound_t::le_zero()) {
+                _empty_status = EMPTY;
+                return true;
+            }
         }
 
         _empty_status = NON_EMPTY;
@@ -85,6 +118,7 @@ namespace pardibaal {
     }
 
     bool DBM::is_satisfying(dim_t x, dim_t y, bound_t g) const {
+        close_if_lazy();
         if (this->is_empty()) return false;
         return bound_t::le_zero() <= (this->_bounds_table.at(y, x) + g);
     }
@@ -102,19 +136,27 @@ namespace pardibaal {
     relation_t DBM::relation(const DBM &dbm) const {
         if (this->dimension() != dbm.dimension())
             return relation_t::different();
-        else if (this->is_empty())
+
+        this->close_if_lazy();
+        dbm.close_if_lazy();
+        if (this->is_empty())
             return dbm.is_empty() ? relation_t::equal() : relation_t::subset();
         else if (dbm.is_empty())
             return relation_t::superset();
 
         bool eq = true, sub = true, super = true;
 
-        for (dim_t i = 0; i < dimension(); ++i)
-            for (dim_t j = 0; j < dimension(); ++j) {
-                sub = sub && this->at(i, j) <= dbm.at(i, j);
-                super = super && this->at(i, j) >= dbm.at(i, j);
-                if (!sub && !super) return relation_t::different();
-            }
+        // Read through const references, so shared bounds are not detached
+        const bounds_table_t &table = this->_bounds_table, &other_table = dbm._bounds_table;
+        const bound_t* lhs = table.row(0);
+        const bound_t* rhs = other_table.row(0);
+
+        auto fixed_relation = [&]<dim_t N>(std::integral_constant<dim_t, N>) {
+            fixed::relation<N>(lhs, rhs, sub, super);
+        };
+
+        if (not fixed::dispatch_fixed(dimension(), fixed_relation))
+            compare_bounds(lhs, rhs, dimension(), sub, super);
 
         eq = sub && super;
 
@@ -139,17 +181,17 @@ namespace pardibaal {
     bool DBM::is_equal(const DBM& dbm)            const {return this->relation(dbm).is_equal();}
     
     template<bool is_exact>
-    bool DBM::is_equal(const Federation &fed)     const {return this->relation<is_exact>(fed).is_equal();}
+    bool DBM::is_equal(const Federation &fed)     const {return fed.is_equal<is_exact>(*this);}
     
     bool DBM::is_subset(const DBM& dbm)           const {return this->relation(dbm).is_subset();}
     
     template<bool is_exact>
-    bool DBM::is_subset(const Federation &fed)    const {return this->relation<is_exact>(fed).is_subset();}
+    bool DBM::is_subset(const Federation &fed)    const {return fed.is_superset<is_exact>(*this);}
     
     bool DBM::is_superset(const DBM& dbm)         const {return this->relation(dbm).is_superset();}
     
     template<bool is_exact>
-    bool DBM::is_superset(const Federation &fed)  const {return this->relation<is_exact>(fed).is_superset();}
+    bool DBM::is_superset(const Federation &fed)  const {return fed.is_subset<is_exact>(*this);}
 
     bool DBM::is_different(const DBM& dbm)        const {return this->relation(dbm).is_different();}
     
@@ -171,28 +213,66 @@ namespace pardibaal {
     template bool DBM::is_different<true>(const Federation& fed) const;
     template bool DBM::is_different<false>(const Federation& fed) const;
 
+    /*
+     * this is not included in aLU(dbm) iff there are clocks x and y (including the zero clock) such that
+     *   this[0, x] >= (-U_x, <=)  and  dbm[y, x] < this[y, x]  and  dbm[y, x] + (-L_y, <) < this[0, x]
+     * A clock without a bound never satisfies the first or last condition. The zero clock has L_0 = U_0 = 0,
+     * whatever the constants at index 0 are. The condition on x is computed once, so both dbms are read row by row.
+     */
+    bool DBM::is_included_lu(const DBM &dbm, const std::vector<val_t> &lower, const std::vector<val_t> &upper) const {
+#ifndef NEXCEPTIONS
+        if (dbm.dimension() != dimension())
+            throw(base_error("ERROR: Cannot check inclusion between dbms with different dimensions. ",
+                             "Got dimensions ", dbm.dimension(), " and ", dimension()));
+        if (this->dimension() != lower.size() || this->dimension() != upper.size())
+            throw base_error("ERROR: Got LU constants vector of size ", lower.size(), " and ", upper.size(),
+                             " but the DBM has ", this->dimension(), " clocks");
+#endif
+        this->close_if_lazy();
+        dbm.close_if_lazy();
+        if (this->is_empty()) return true;
+        if (dbm.is_empty()) return false;
+
+        // Read through const references, so shared bounds are not detached
+        const bounds_table_t &table = this->_bounds_table, &other_table = dbm._bounds_table;
+        const bound_t* row_0 = table.row(0);
+        std::vector<bool> is_upper_bounded(dimension());
+        is_upper_bounded[0] = true;
+        for (dim_t x = 1; x < dimension(); ++x)
+            is_upper_bounded[x] = upper[x] >= 0 && row_0[x] >= bound_t::non_strict(-upper[x]);
+
+        for (dim_t y = 0; y < dimension(); ++y) {
+            const val_t lower_bound = y == 0 ? 0 : lower[y];
+            if (lower_bound < 0) continue;
+            const bound_t lower_y = bound_t::strict(-lower_bound);
+            const bound_t* row = table.row(y);
+            const bound_t* other_row = other_table.row(y);
+
+            for (dim_t x = 0; x < dimension(); ++x) {
+                if (x == y || !is_upper_bounded[x]) continue;
+                if (other_row[x] < row[x] && other_row[x] + lower_y < row_0[x])
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
     bool DBM::is_intersecting(const DBM &dbm) const {
 #ifndef NEXCEPTIONS
         if (dbm.dimension() != dimension())
             throw(base_error("ERROR: Cannot measure intersection of two dbms with different dimensions. ",
                              "Got dimensions ", dbm.dimension(), " and ", dimension()));
 #endif
+        this->close_if_lazy();
+        dbm.close_if_lazy();
         if (this->is_empty() || dbm.is_empty()) return false;
-        for (dim_t i = 0; i < dimension(); ++i) {
-            for (dim_t j = 0; j < dimension(); ++j) {
-                bound_t b1 = this->at(i, j);
-                bound_t b2 = dbm.at(j, i);
-
-                // For opposite diagonal bounds: if they are both + or -, then they overlap
-                // Upper bounds can be inf; if upper bound is inf, then it overlaps with any opposite lower bound
-                if ((b1 > bound_t::le_zero() && b2 > bound_t::le_zero()) ||
-                    (b1 < bound_t::le_zero() && b2 < bound_t::le_zero()) ||
-                    (b1.is_inf() || b2.is_inf()))
-                    continue;
-                else if (((b1.is_strict() || b2.is_strict()) && (not (b1 * -1 < b2))) || (not (b1 * -1 <= b2)))
+
+        // Two closed zones are disjoint iff some pair of opposite bounds forms a negative cycle
+        for (dim_t i = 0; i < dimension(); ++i)
+            for (dim_t j = 0; j < dimension(); ++j)
+                if (this->at(i, j) + dbm.at(j, i) < bound_t::le_zero())
                     return false;
-            }
-        }
 
         return true;
     }
@@ -202,6 +282,7 @@ namespace pardibaal {
     }
 
     bool DBM::is_unbounded() const {
+        close_if_lazy();
         if (is_empty()) return false;
 
         for (dim_t i = 1; i < dimension(); ++i)
@@ -211,21 +292,127 @@ namespace pardibaal {
         return true;
     }
 
+    std::vector<difference_bound_t> DBM::minimal_constraints() const {
+        close_if_lazy();
+        std::vector<difference_bound_t> constraints;
+        if (is_empty()) {
+            constraints.emplace_back(0, 0, bound_t::lt_zero());
+            return constraints;
+        }
+
+        // Each clock is in the class of the lowest clock it has a zero cycle with, which is the leader of the class
+        const dim_t dimension = this->dimension();
+        std::vector<dim_t> leader(dimension), last(dimension);
+
+        // Every DBM includes x >= 0, so it is left out
+        auto add = [this, &constraints](dim_t i, dim_t j) {
+            if (i != 0 || at(i, j) != bound_t::le_zero())
+                constraints.emplace_back(i, j, at(i, j));
+        };
+
+        for (dim_t i = 0; i < dimension; ++i) {
+            leader[i] = last[i] = i;
+            for (dim_t j = 0; j < i; ++j) {
+                if (at(i, j) + at(j, i) == bound_t::le_zero()) {
+                    leader[i] = leader[j];
+                    break;
+                }
+            }
+
+            // Chain the clocks of a class in increasing order, and close the cycle below
+            if (leader[i] != i) {
+                add(last[leader[i]], i);
+                last[leader[i]] = i;
+            }
+        }
+        for (dim_t i = 0; i < dimension; ++i)
+            if (leader[i] == i && last[i] != i)
+                add(last[i], i);
+
+        // The lower bound of a class is implied by x >= 0 if the lower bound of one of its clocks is 0
+        std::vector<bool> is_lower_implied(dimension, false);
+        for (dim_t i = 1; i < dimension; ++i)
+            if (leader[i] != 0 && at(0, i) == bound_t::le_zero())
+                is_lower_implied[leader[i]] = true;
+
+        // Since the DBM is closed, a constraint between leaders is implied iff it is the sum over a third leader
+        for (dim_t i = 0; i < dimension; ++i) {
+            if (leader[i] != i) continue;
+            for (dim_t j = 0; j < dimension; ++j) {
+                if (leader[j] != j || i == j || at(i, j).is_inf()) continue;
+                if (i == 0 && is_lower_implied[j]) continue;
+
+                bool is_implied = false;
+                for (dim_t k = 0; k < dimension && not is_implied; ++k)
+                    is_implied = leader[k] == k && k != i && k != j && at(i, k) + at(k, j) <= at(i, j);
+
+                if (not is_implied)
+                    add(i, j);
+            }
+        }
+
+        return constraints;
+    }
+
+    uint64_t DBM::hash() const {
+        close_if_lazy();
+        if (is_empty())
+            return hash_finalize(~(uint64_t) dimension());
+        return hash_finalize(_bounds_table.hash() ^ dimension());
+    }
+
     void DBM::close() {
+        canonicalize();
+    }
+
+    void DBM::canonicalize() const {
         if (_is_closed) return;
 
-        const dim_t size = this->dimension();
+        const bool is_consistent = _dirty_clock != NO_CLOCK
+                ? close_bounds_clock(_bounds_table.row(0), this->dimension(), _dirty_clock)
+                : close_bounds(_bounds_table.row(0), this->dimension());
+        set_closed_status(is_consistent);
+    }
+
+    void DBM::close(const std::vector<dim_t>& clocks) {
+        // Each clock costs roughly three passes over the matrix, compared to n passes for the full closure
+        if (clocks.size() * 3 >= this->dimension()) {
+            mark_unclosed();
+            this->close();
+            return;
+        }
+
+        bool is_consistent = true;
+        for (dim_t x : clocks) {
+            is_consistent = close_bounds_clock(_bounds_table.row(0), this->dimension(), x);
+            if (not is_consistent) break;
+        }
+        set_closed_status(is_consistent);
+    }
 
-        for(dim_t k = 0; k < size; ++k)
-            for(dim_t i = 0; i < size; ++i)
-                for(dim_t j = 0; j < size; ++j)
-                    _bounds_table.set(i, j, bound_t::min(_bounds_table.at(i, j),
-                                                              _bounds_table.at(i, k) + _bounds_table.at(k, j)));
+    void DBM::close_changed(std::vector<dim_t>& changed) {
+        if (not _is_closed) {
+            if (_dirty_clock == NO_CLOCK) {
+                this->close();
+                return;
+            }
+            changed.push_back(_dirty_clock);
+        }
+        if (not changed.empty())
+            this->close(changed);
+    }
 
+    void DBM::set_closed_status(bool is_consistent) const {
         _is_closed = true;
+        // A status of EMPTY may come from a constraint that was never written to the bounds, so it is kept
+        if (not is_consistent)
+            _empty_status = EMPTY;
+        else if (_empty_status == UNKNOWN)
+            _empty_status = NON_EMPTY;
     }
 
     void DBM::future() {
+        canonicalize();
         for (dim_t i = 1; i < this->dimension(); ++i)
             _bounds_table.set(i, 0, bound_t::inf());
     }
@@ -235,6 +422,7 @@ namespace pardibaal {
     }
 
     void DBM::past() {
+        canonicalize();
         for (dim_t i = 1; i < this->dimension(); ++i) {
             this->_bounds_table.set(0, i, bound_t::le_zero());
             for (dim_t j = 1; j < this->dimension(); ++j) {
@@ -265,17 +453,20 @@ namespace pardibaal {
     }
 
     void DBM::restrict(dim_t x, dim_t y, bound_t g) {
+        canonicalize();
         if ((_bounds_table.at(y, x) + g) < bound_t::le_zero()) // In this case the zone is now empty
             _empty_status = EMPTY;
         else if (g < _bounds_table.at(x, y)) {
-            _bounds_table.set(x, y, g);
+            // Every new shortest path is i -> x -> y -> j. The bounds into x and out of y do not change, since
+            // g + at(y, x) >= (0, <=), so the bounds can be updated in place. This also sets the bound from x to y.
             for (dim_t i = 0; i < this->dimension(); ++i) {
+                const bound_t b_ix = _bounds_table.at(i, x);
+                if (b_ix.is_inf()) continue;
+                const bound_t b_iy = b_ix + g;
                 for (dim_t j = 0; j < this->dimension(); ++j) {
-                    if (_bounds_table.at(i, x) + _bounds_table.at(x, j) < _bounds_table.at(i, j))
-                        _bounds_table.set(i, j, _bounds_table.at(i, x) + _bounds_table.at(x, j));
-
-                    if (_bounds_table.at(i, y) + _bounds_table.at(y, j) < _bounds_table.at(i, j))
-                        _bounds_table.set(i, j, _bounds_table.at(i, y) + _bounds_table.at(y, j));
+                    const bound_t b = b_iy + _bounds_table.at(y, j);
+                    if (b < _bounds_table.at(i, j))
+                        _bounds_table.set(i, j, b);
                 }
             }
         }
@@ -286,11 +477,39 @@ namespace pardibaal {
     }
 
     void DBM::restrict(const std::vector<difference_bound_t> &constraints) {
-        for (const auto& c : constraints)
-            this->restrict(c);
+        if (constraints.size() == 1) {
+            this->restrict(constraints[0]);
+            return;
+        }
+
+        // Tighten all constraints first, and close once afterwards
+        std::vector<bool> is_pivot(this->dimension(), false);
+        std::vector<dim_t> pivots;
+
+        for (const auto& c : constraints) {
+            if ((_bounds_table.at(c._j, c._i) + c._bound) < bound_t::le_zero()) {
+                _empty_status = EMPTY;
+                return;
+            }
+            if (c._bound < _bounds_table.at(c._i, c._j)) {
+                _bounds_table.set(c._i, c._j, c._bound);
+                // One clock of each changed bound suffices for the incremental closure
+                if (not is_pivot[c._i] && not is_pivot[c._j]) {
+                    is_pivot[c._i] = true;
+                    pivots.push_back(c._i);
+                }
+            }
+        }
+
+        if (pivots.empty()) return;
+
+        if (_empty_status != EMPTY)
+            _empty_status = UNKNOWN;
+        this->close_changed(pivots);
     }
 
     void DBM::free(dim_t x) {
+        canonicalize();
         for (dim_t i = 0; i < dimension(); ++i) {
             if (i != x) {
                 _bounds_table.set(x, i, bound_t::inf());
@@ -301,6 +520,7 @@ namespace pardibaal {
 
     // x := m
     void DBM::assign(dim_t x, val_t m) {
+        canonicalize();
         for (dim_t i = 0; i < this->dimension(); ++i) {
             _bounds_table.set(x, i, bound_t::non_strict(m) + _bounds_table.at(0, i));
             _bounds_table.set(i, x, bound_t::non_strict(-m) + _bounds_table.at(i, 0));
@@ -309,6 +529,7 @@ namespace pardibaal {
 
     // x := y
     void DBM::copy(dim_t x, dim_t y) {
+        canonicalize();
         for (dim_t i = 0; i < this->dimension(); ++i) {
             if (i != x) {
                 _bounds_table.set(x, i, _bounds_table.at(y, i));
@@ -320,6 +541,7 @@ namespace pardibaal {
     }
 
     void DBM::shift(dim_t x, val_t n) {
+        canonicalize();
         for (dim_t i = 0; i < this->dimension(); ++i) {
             if (i != x) {
                 this->_bounds_table.set(x, i, this->_bounds_table.at(x, i) + bound_t::non_strict(n));
@@ -337,58 +559,80 @@ namespace pardibaal {
             throw base_error("ERROR: Got max constants vector of size ", ceiling.size(), " but the DBM has ",
                              this->dimension(), " clocks");
 #endif
+        canonicalize();
+        std::vector<dim_t> changed;
 
         for (dim_t i = 0; i < this->dimension(); ++i) {
+            bool row_changed = false;
             for (dim_t j = 0; j < this->dimension(); ++j) {
                 if (!this->_bounds_table.at(i, j).is_inf() && this->_bounds_table.at(i, j) > bound_t::non_strict(ceiling[i])){
                     this->_bounds_table.set(i, j, bound_t::inf());
+                    row_changed = true;
                 }
                 else if (!this->_bounds_table.at(i, j).is_inf() && this->_bounds_table.at(i, j) < bound_t::strict(-ceiling[j])) {
                     this->_bounds_table.set(i, j, bound_t::strict(-ceiling[j]));
+                    row_changed = true;
                 }
             }
+            if (row_changed)
+                changed.push_back(i);
         }
 
-        _is_closed = false;
-        close();
+        this->close_changed(changed);
     }
 
+    /*
+     * The extrapolations below update the bounds in place. Each bound only depends on its own original value and
+     * the original lower bounds in row 0, so row 0 is updated last. Only the changed rows are closed afterwards.
+     * Rows are visited as i = r % dimension for r = 1, ..., dimension.
+     */
+
     void DBM::extrapolate_diagonal(const std::vector<val_t> &ceiling) {
 #ifndef NEXCEPTIONS
         if (this->dimension() != ceiling.size())
             throw base_error("ERROR: Got max constants vector of size ", ceiling.size(), " but the DBM has ",
                              this->dimension(), " clocks");
 #endif
-        DBM D(*this);
+        canonicalize();
+        if (this->is_empty()) return;
 
-        for (dim_t i = 0; i < D.dimension(); ++i) {
-            for (dim_t j = 0; j < D.dimension(); ++j) {
+        std::vector<dim_t> changed;
+
+        for (dim_t r = 1; r <= this->dimension(); ++r) {
+            const dim_t i = r % this->dimension();
+            bool row_changed = false;
+            for (dim_t j = 0; j < this->dimension(); ++j) {
                 if (i == j) continue;
-                if ((D.at(i, j).get_bound() > ceiling[i]) ||
-                    (-D.at(0, i).get_bound() > ceiling[i]) ||
-                    (-D.at(0, j).get_bound() > ceiling[j] && i != 0)){
+                const bound_t old = this->at(i, j);
+                bound_t b = old;
 
-                    this->set(i, j, bound_t::inf());
+                if ((old.get_bound() > ceiling[i]) ||
+                    (-this->at(0, i).get_bound() > ceiling[i]) ||
+                    (-this->at(0, j).get_bound() > ceiling[j] && i != 0)) {
+
+                    b = bound_t::inf();
                 }
-                else if (-D.at(i, j).get_bound() > ceiling[j] && i == 0)
-                    this->set(i, j, bound_t::strict(-ceiling[j]));
+                else if (-old.get_bound() > ceiling[j] && i == 0)
+                    b = bound_t::strict(-ceiling[j]);
 
                 // Make sure we don't set 0, j to positive bound or i, 0 to a negative one
                 //TODO: We only do this because regular close() does not catch these.
                 // We should propably use a smarter close()
-                if (i == 0 && this->at(i, j) > bound_t::le_zero()) {
-                    this->set(i, j, bound_t::le_zero());
-                }
-                if (j == 0 && this->at(i, j) < bound_t::le_zero()) {
-                    this->set(i, j, bound_t::le_zero());
+                if (i == 0 && b > bound_t::le_zero())
+                    b = bound_t::le_zero();
+                if (j == 0 && b < bound_t::le_zero())
+                    b = bound_t::le_zero();
+
+                if (b != old) {
+                    _bounds_table.set(i, j, b);
+                    row_changed = true;
                 }
-
             }
+            if (row_changed)
+                changed.push_back(i);
         }
 
-        //TODO: Do something smart where we only close if something changes
-        _is_closed = false;
-        this->close();
+        this->close_changed(changed);
     }
 
     void DBM::extrapolate_lu(const std::vector<val_t> &lower, const std::vector<val_t> &upper) {
@@ -397,29 +641,51 @@ namespace pardibaal {
             throw base_error("ERROR: Got LU constants vector of size ", lower.size(), " and ", upper.size(),
                              " but the DBM has ", this->dimension(), " clocks");
 #endif
-        DBM D(*this);
+        canonicalize();
+        if (this->is_empty()) return;
+
+        auto fixed_extrapolate = [&]<dim_t N>(std::integral_constant<dim_t, N>) {
+            if (fixed::extrapolate_lu<N>(_bounds_table.row(0), lower.data(), upper.data())) {
+                mark_unclosed();
+                this->close();
+            }
+        };
+
+        if (fixed::dispatch_fixed(this->dimension(), fixed_extrapolate))
+            return;
+
+        std::vector<dim_t> changed;
 
-        for (dim_t i = 0; i < D.dimension(); ++i) {
-            for (dim_t j = 0; j < D.dimension(); ++j) {
+        for (dim_t i = 0; i < this->dimension(); ++i) {
+            bool row_changed = false;
+            for (dim_t j = 0; j < this->dimension(); ++j) {
                 if (i == j) continue;
-                else if (D.at(i, j).get_bound() > lower[i])
-                    this->set(i, j, bound_t::inf());
-                else if (-D.at(i, j).get_bound() > upper[j])
-                    this->set(i, j, bound_t::strict(-upper[j]));
+                const bound_t old = this->at(i, j);
+                bound_t b = old;
+
+                if (old.get_bound() > lower[i])
+                    b = bound_t::inf();
+                else if (-old.get_bound() > upper[j])
+                    b = bound_t::strict(-upper[j]);
 
                 // Make sure we don't set 0, j to positive bound or i, 0 to a negative one
                 //TODO: We only do this because regular close() does not catch these.
                 // We should propably use a smarter close()
-                if (i == 0 && this->at(i, j) > bound_t::le_zero())
-                    this->set(i, j, bound_t::le_zero());
-                if (j == 0 && this->at(i, j) < bound_t::le_zero())
-                    this->set(i, j, bound_t::le_zero());
+                if (i == 0 && b > bound_t::le_zero())
+                    b = bound_t::le_zero();
+                if (j == 0 && b < bound_t::le_zero())
+                    b = bound_t::le_zero();
+
+                if (b != old) {
+                    _bounds_table.set(i, j, b);
+                    row_changed = true;
+                }
             }
+            if (row_changed)
+                changed.push_back(i);
         }
 
-        //TODO: Do something smart where we only close if something changes
-        _is_closed = false;
-        this->close();
+        this->close_changed(changed);
     }
 
     void DBM::extrapolate_lu_diagonal(const std::vector<val_t> &lower, const std::vector<val_t> &upper) {
@@ -428,31 +694,86 @@ namespace pardibaal {
             throw base_error("ERROR: Got LU constants vector of size ", lower.size(), " and ", upper.size(),
                              " but the DBM has ", this->dimension(), " clocks");
 #endif
-        DBM D(*this);
+        canonicalize();
+        if (this->is_empty()) return;
 
-        for (dim_t i = 0; i < D.dimension(); ++i) {
-            for (dim_t j = 0; j < D.dimension(); ++j) {
+        std::vector<dim_t> changed;
+
+        for (dim_t r = 1; r <= this->dimension(); ++r) {
+            const dim_t i = r % this->dimension();
+            bool row_changed = false;
+            for (dim_t j = 0; j < this->dimension(); ++j) {
                 if (i == j) continue;
-                else if ((D.at(i, j).get_bound() > lower[i]) ||
-                         (-D.at(0, i).get_bound() > -lower[i]) ||
-                         (-D.at(0, j).get_bound() > -upper[j] && i != 0))
-                    this->set(i, j, bound_t::inf());
-                else if (-D.at(0, j).get_bound() > upper[j] && i == 0)
-                    this->set(i, j, bound_t::strict(-upper[j]));
+                const bound_t old = this->at(i, j);
+                bound_t b = old;
+
+                if ((old.get_bound() > lower[i]) ||
+                    (-this->at(0, i).get_bound() > lower[i]) ||
+                    (-this->at(0, j).get_bound() > upper[j] && i != 0))
+                    b = bound_t::inf();
+                else if (-old.get_bound() > upper[j] && i == 0)
+                    b = bound_t::strict(-upper[j]);
 
                 // Make sure we don't set 0, j to positive bound or i, 0 to a negative one
                 //TODO: We only do this because regular close() does not catch these.
                 // We should propably use a smarter close()
-                if (i == 0 && this->at(i, j) > bound_t::le_zero())
-                    this->set(i, j, bound_t::le_zero());
-                if (j == 0 && this->at(i, j) < bound_t::le_zero())
-                    this->set(i, j, bound_t::le_zero());
+                if (i == 0 && b > bound_t::le_zero())
+                    b = bound_t::le_zero();
+                if (j == 0 && b < bound_t::le_zero())
+                    b = bound_t::le_zero();
+
+                if (b != old) {
+                    _bounds_table.set(i, j, b);
+                    row_changed = true;
+                }
             }
+            if (row_changed)
+                changed.push_back(i);
+        }
+
+        this->close_changed(changed);
+    }
+
+    void DBM::extrapolate(const extrapolation_t& extrapolation) {
+#ifndef NEXCEPTIONS
+        if (this->dimension() != extrapolation.dimension())
+            throw base_error("ERROR: Got extrapolation constants for ", extrapolation.dimension(),
+                             " clocks but the DBM has ", this->dimension(), " clocks");
+#endif
+        canonicalize();
+        if (this->is_empty()) return;
+
+        std::vector<dim_t> changed;
+        const bound_t* row_0 = _bounds_table.row(0);
+
+        for (dim_t r = 1; r <= this->dimension(); ++r) {
+            const dim_t i = r % this->dimension();
+            if (extrapolation.extrapolate_row(_bounds_table.row(i), row_0, i))
+                changed.push_back(i);
         }
 
-        //TODO: Do something smart where we only close if something changes
-        _is_closed = false;
-        this->close();
+        this->close_changed(changed);
+    }
+
+    void DBM::convex_union(const DBM &dbm) {
+#ifndef NEXCEPTIONS
+        if (dbm.dimension() != dimension())
+            throw(base_error("ERROR: Cannot take convex union of two dbms with different dimensions. ",
+                             "Got dimensions ", dbm.dimension(), " and ", dimension()));
+#endif
+        this->canonicalize();
+        dbm.close_if_lazy();
+        if (dbm.is_empty()) return;
+        if (this->is_empty()) {
+            *this = dbm;
+            return;
+        }
+
+        // The max of closed bounds is closed, so the DBM stays closed and non-empty
+        for (dim_t i = 0; i < dimension(); ++i)
+            for (dim_t j = 0; j < dimension(); ++j)
+                if (dbm.at(i, j) > this->at(i, j))
+                    _bounds_table.set(i, j, dbm.at(i, j));
     }
 
     void DBM::intersection(const DBM &dbm) {
@@ -461,18 +782,28 @@ namespace pardibaal {
             throw(base_error("ERROR: Cannot take intersection of two dbms with different dimensions. ",
                              "Got dimensions ", dbm.dimension(), " and ", dimension()));
 #endif
+        dbm.close_if_lazy();
         if (dbm.is_empty() || this->is_empty()) {
             this->_empty_status = EMPTY;
             return;
         }
 
-        for (dim_t i = 0; i < dimension(); ++i)
-            for (dim_t j = 0; j < dimension(); ++j)
-                this->_bounds_table.set(i, j, bound_t::min(this->at(i, j), dbm.at(i, j)));
+        std::vector<dim_t> changed;
+
+        for (dim_t i = 0; i < dimension(); ++i) {
+            bool row_changed = false;
+            for (dim_t j = 0; j < dimension(); ++j) {
+                if (dbm.at(i, j) < this->at(i, j)) {
+                    this->_bounds_table.set(i, j, dbm.at(i, j));
+                    row_changed = true;
+                }
+            }
+            if (row_changed)
+                changed.push_back(i);
+        }
 
         _empty_status = UNKNOWN;
-        _is_closed = false;
-        this->close();
+        this->close_changed(changed);
     }
 
     void DBM::remove_clock(dim_t c) {
@@ -482,7 +813,8 @@ namespace pardibaal {
         if (c >= this->dimension())
             throw base_error("ERROR: Removing clock ", c, " but the DBM only has clocks from 0 to ", dimension() - 1);
 #endif
-        DBM D(dimension() - 1);
+        canonicalize();
+        DBM D(dimension() - 1, this->get_allocator());
 
         for (dim_t i = 0, i2 = 0; i < dimension(); ++i, ++i2) {
             for (dim_t j = 0, j2 = 0; j < dimension(); ++j) {
@@ -497,6 +829,7 @@ namespace pardibaal {
     }
 
     void DBM::swap_clocks(dim_t a, dim_t b) {
+        canonicalize();
 #ifndef NEXCEPTIONS
         if (a == 0 || b == 0)
             throw base_error("ERROR: Cannot swap the zero clock");
@@ -531,7 +864,8 @@ namespace pardibaal {
             throw base_error("ERROR: Adding clock at index", c, " but the DBM only has clocks from 0 to ", dimension() - 1);
 #endif
 
-        DBM D(dimension() + 1);
+        canonicalize();
+        DBM D(dimension() + 1, this->get_allocator());
 
         for (dim_t i = 0, i2 = 0; i < D.dimension(); ++i, ++i2) {
             for (dim_t j = 0, j2 = 0; j < D.dimension(); ++j) {
@@ -560,7 +894,8 @@ namespace pardibaal {
             throw base_error("ERROR: Mismatch in number of 1 bits/true values in src ", src, " and dst ", dst);
 #endif
 
-        DBM dest_dbm(dst_bits.size());
+        canonicalize();
+        DBM dest_dbm(dst_bits.size(), this->get_allocator());
 
         std::vector<dim_t> src_indir(src_bits.size(), 0);
         dim_t dst_cnt = 0;
@@ -608,7 +943,8 @@ namespace pardibaal {
                                  " which is outside of the new dimension of ", new_size);
 #endif
 
-        DBM D(new_size);
+        canonicalize();
+        DBM D(new_size, this->get_allocator());
 
         for (dim_t i = 0; i < this->dimension(); ++i) {
             for (dim_t j = 0; j < this->dimension(); ++j) {
@@ -25,10 +25,12 @@
 
 #include <vector>
 #include <ostream>
+#include <functional>
 
 #include "bound_t.h"
 #include "bounds_table_t.h"
 #include "difference_bound_t.h"
+#include "extrapolation_t.h"
 
 namespace pardibaal {
     class Federation;
@@ -61,23 +63,92 @@ namespace pardibaal {
         [[nodiscard]] bool is_different() const;
     };
 
+    /**
+     * A zone as a difference bound matrix, which is closed on demand after set().
+     * Operations that modify the DBM close it first. Queries only do so in lazy mode (see set_lazy()),
+     * and then write to the DBM: a lazy DBM shared between threads must be closed (see close())
+     * before the threads query it concurrently.
+     * hash() also caches the hash in the DBM, so it must have been called once before the threads hash it,
+     * eg. with ZoneStore::is_covered or ZoneStore::insert.
+     */
     class DBM {
         enum empty_status_e {EMPTY, NON_EMPTY, UNKNOWN};
 
-        bounds_table_t _bounds_table;
+        static constexpr dim_t NO_CLOCK = ~dim_t(0);
+
+        // Mutable such that queries can close a lazy DBM on demand, see close_if_lazy
+        mutable bounds_table_t _bounds_table;
         mutable empty_status_e _empty_status = NON_EMPTY;
         mutable bool _is_closed = true;
+        // If not closed: the only clock whose row and column changed since the DBM was closed, or NO_CLOCK
+        dim_t _dirty_clock = NO_CLOCK;
+        bool _is_lazy = false;
+
+        // Closes the DBM if it is not, incrementally if only a single clock changed since it was closed
+        void canonicalize() const;
+
+        // Closes the DBM before a query in lazy mode. Otherwise queries read the bounds as they are.
+        inline void close_if_lazy() const {
+            if (_is_lazy) canonicalize();
+        }
+
+        // Closes after the bounds of the changed clocks were written directly to the bounds table
+        void close_changed(std::vector<dim_t>& changed);
+
+        // Marks that the DBM needs a full closure
+        inline void mark_unclosed() {
+            _is_closed = false;
+            _dirty_clock = NO_CLOCK;
+        }
+
+        // Marks the DBM as closed after a closure that found it consistent or inconsistent
+        void set_closed_status(bool is_consistent) const;
+
+        // Operates directly on caller-provided bounds, see DBMView
+        DBM(bound_t* bounds, dim_t number_of_clocks, bool is_closed);
+        friend class DBMView;
 
     public:
-        DBM(dim_t number_of_clocks);
+        /**
+         * The DBM is allocator-aware, such that containers like std::pmr::vector<DBM> (eg. in Federation)
+         * propagate their memory resource to the bounds of the zones they store.
+         */
+        using allocator_type = bounds_table_t::allocator_type;
 
-        static DBM zero(dim_t dimension);
+        DBM(dim_t number_of_clocks, const allocator_type& alloc = {});
 
-        static DBM unconstrained(dim_t dimension);
+        /* Copies of DBMs larger than the inline dimension share their bounds until either is written
+         * (see bounds_table_t), so a DBM must not be written while a copy of it is used on another thread. */
+        DBM(const DBM& dbm) = default;
+        DBM(DBM&& dbm) noexcept = default;
+        DBM(const DBM& dbm, const allocator_type& alloc);
+        DBM(DBM&& dbm, const allocator_type& alloc);
 
+        DBM& operator=(const DBM& dbm) = default;
+        DBM& operator=(DBM&& dbm) noexcept = default;
+
+        static DBM zero(dim_t dimension, const allocator_type& alloc = {});
+
+        static DBM unconstrained(dim_t dimension, const allocator_type& alloc = {});
+
+        [[nodiscard]] allocator_type get_allocator() const;
+
+        /**
+         * The bound from clock i to clock j, as stored. Call close() first to read canonical bounds after set().
+         */
         [[nodiscard]] inline bound_t at(dim_t i, dim_t j) const { return this->_bounds_table.at(i, j); }
 
+        /**
+         * Sets a bound without closing the DBM. The DBM is closed by the next operation that modifies it,
+         * or by close(). Queries such as is_empty() and relation() read the bounds as they are, unless the DBM is lazy.
+         * If all bounds set since the last closure are in the row or column of the same clock,
+         * the closure is incremental.
+         */
         inline void set(dim_t i, dim_t j, bound_t bound) {
+            if (_is_closed)
+                _dirty_clock = i;
+            else if (_dirty_clock != i && _dirty_clock != j)
+                _dirty_clock = NO_CLOCK;
             this->_bounds_table.set(i, j, bound);
             _is_closed = false;
             _empty_status = UNKNOWN;
@@ -89,6 +160,14 @@ namespace pardibaal {
 
         [[nodiscard]] inline empty_status_e empty_status() const { return _empty_status; }
 
+        /**
+         * In lazy mode, queries that need the canonical form close the DBM first, so they can follow set() directly.
+         * Such queries write to the DBM although they are const, see the class documentation.
+         * The mode is off by default and is kept by copies.
+         */
+        inline void set_lazy(bool is_lazy) {_is_lazy = is_lazy;}
+        [[nodiscard]] inline bool is_lazy() const {return _is_lazy;}
+
         void subtract(dim_t i, dim_t j, bound_t bound);
         void subtract(difference_bound_t constraint);
 
@@ -137,6 +216,21 @@ namespace pardibaal {
         template<bool is_exact = true>
         [[nodiscard]] bool is_different(const Federation& fed) const;
 
+        /**
+         * Inclusion in the LU abstraction of a dbm: this is a subset of aLU(dbm).
+         * O(n^2) and needs neither extrapolation nor a copy of either dbm, so the stored zone can be kept exact.
+         * Read about this in
+         *   Herbreteau, Frédéric & Srivathsan, B. & Walukiewicz, Igor. (2012).
+         *   Better Abstractions for Timed Automata. 375-384. 10.1109/LICS.2012.48.
+         * @param dbm the zone whose abstraction this is tested against
+         * The constants at index 0 are ignored, the zero clock is always bounded by 0 as the test requires.
+         * @param lower maximal lower bound constants (L) for each clock. Negative values mean no bound.
+         * @param upper maximal upper bound constants (U) for each clock. Negative values mean no bound.
+         * @return true if this is included in aLU(dbm)
+         */
+        [[nodiscard]] bool is_included_lu(const DBM& dbm, const std::vector<val_t>& lower,
+                                          const std::vector<val_t>& upper) const;
+
         [[nodiscard]] inline relation_t exact_relation(const Federation& fed) const {return this->relation<true>(fed);}
         [[nodiscard]] inline relation_t approx_relation(const Federation& fed) const {return this->relation<false>(fed);}
 
@@ -170,8 +264,40 @@ namespace pardibaal {
          */
         [[nodiscard]] bool is_unbounded() const;
 
+        /**
+         * A smallest set of constraints whose conjunction is this DBM (the reduced graph of Larsen et al. 1997).
+         * Clocks with a fixed difference form one class, given by a cycle of constraints through its clocks,
+         * and constraints between the lowest clocks of classes are kept only if no third class implies them.
+         * An empty DBM gives the single constraint x0 - x0 < 0.
+         * @return the constraints, except x >= 0, which holds in every DBM
+         */
+        [[nodiscard]] std::vector<difference_bound_t> minimal_constraints() const;
+
+        /**
+         * 64-bit hash of the canonical bounds, such that equal DBMs (see is_equal) have equal hashes.
+         * All empty DBMs of a dimension hash to the same value.
+         * The hash is kept by the DBM and updated in O(1) per bound by set(), so repeated calls are cheap.
+         * Operations that close the DBM or write whole rows make the next call recompute it in O(n^2).
+         * A call that computes the hash writes it to the DBM, so it is not safe on a DBM shared between threads
+         * unless the hash is already kept.
+         */
+        [[nodiscard]] uint64_t hash() const;
+
+        /**
+         * Closes the DBM (canonical form). Stops as soon as a negative cycle is found,
+         * so is_empty() is known without further work afterwards.
+         * Operations that need the canonical form close the DBM themselves, see set().
+         */
         void close();
 
+        /**
+         * Incremental closure after only the rows and columns of the given clocks have changed.
+         * The DBM must have been closed before those changes were made.
+         * Runs in O(k * n^2) for k clocks, and falls back to close() when that is not cheaper.
+         * @param clocks the clocks whose bounds have changed, may include the zero clock
+         */
+        void close(const std::vector<dim_t>& clocks);
+
         /**
          * Also known as "up" raises all upper bounds to inf
          */
@@ -203,7 +329,14 @@ namespace pardibaal {
 
         void restrict(dim_t x, dim_t y, bound_t g);
         void restrict(const difference_bound_t& constraint);
+
+        /**
+         * Restrict with a conjunction of constraints, eg. a guard.
+         * All constraints are applied before a single (incremental or full) closure.
+         * @param constraints the constraints that must all be satisfied
+         */
         void restrict(const std::vector<difference_bound_t>& constraints);
+
         void free(dim_t x);
         void assign(dim_t x, val_t m);
         void copy(dim_t x, dim_t y);
@@ -236,6 +369,12 @@ namespace pardibaal {
          */
         void extrapolate_lu_diagonal(const std::vector<val_t> &lower, const std::vector<val_t> &upper);
 
+        /**
+         * Extrapolates with precompiled constants. Same result as the extrapolate* function of the context's kind.
+         * @param extrapolation context made for a DBM of this dimension
+         */
+        void extrapolate(const extrapolation_t& extrapolation);
+
         /**
          * Sets this to the intersection between this and dbm
          * this = this intersect dbm
@@ -243,6 +382,13 @@ namespace pardibaal {
          */
         void intersection(const DBM& dbm);
 
+        /**
+         * Sets this to the convex hull of this and dbm, ie. the smallest zone including both,
+         * which is the element-wise max of the canonical bounds. The result is closed.
+         * @param dbm the zone included in the hull
+         */
+        void convex_union(const DBM& dbm);
+
         /** Remove clock at index c
         *
         * @param c index of clock to be removed
@@ -292,4 +438,9 @@ namespace pardibaal {
     std::ostream& operator<<(std::ostream& out, const DBM& D);
 }
 
+template<>
+struct std::hash<pardibaal::DBM> {
+    std::size_t operator()(const pardibaal::DBM& dbm) const {return dbm.hash();}
+};
+
 #endif //PARDIBAAL_DBM_H
@@ -0,0 +1,134 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARDIBAAL_DBMVIEW_H
+#define PARDIBAAL_DBMVIEW_H
+
+#include <vector>
+#include <ostream>
+
+#include "bound_t.h"
+#include "difference_bound_t.h"
+#include "DBM.h"
+
+namespace pardibaal {
+
+    /**
+     * A DBM stored in caller-provided memory.
+     * The bounds are read and written in place, so zones kept in eg. state vectors, arenas or
+     * memory mapped files can be operated on without copying them in and out of a DBM.
+     * Only operations that keep the dimension are available.
+     * Copying the view (or dbm()) into a DBM or federation copies the bounds.
+     * While the view exists, the bounds may be unclosed (after set()) and need not show that the zone is empty.
+     * The destructor closes them, and sets the bound from the zero clock to itself to (<0) if the zone is empty,
+     * so a later view of the same memory has the same zone.
+     */
+    class DBMView {
+        DBM _dbm;
+
+    public:
+        /**
+         * @param bounds dimension * dimension bounds in row-major order, which must outlive the view
+         * @param dimension number of clocks including the zero clock
+         * @param is_closed whether the bounds are already on canonical (closed) form, as left by a previous view
+         */
+        DBMView(bound_t* bounds, dim_t dimension, bool is_closed = true) : _dbm(bounds, dimension, is_closed) {}
+
+        ~DBMView() {
+            _dbm.canonicalize();
+            if (_dbm.is_empty())
+                _dbm._bounds_table.set(0, 0, bound_t::lt_zero());
+        }
+
+        DBMView(const DBMView&) = delete;
+        DBMView& operator=(const DBMView&) = delete;
+
+        /** The view as a DBM, eg. for relations with DBMs and federations */
+        [[nodiscard]] inline const DBM& dbm() const {return _dbm;}
+
+        [[nodiscard]] inline bound_t at(dim_t i, dim_t j) const {return _dbm.at(i, j);}
+        inline void set(dim_t i, dim_t j, bound_t bound) {_dbm.set(i, j, bound);}
+        inline void set(const difference_bound_t& constraint) {_dbm.set(constraint);}
+
+        [[nodiscard]] inline dim_t dimension() const {return _dbm.dimension();}
+        [[nodiscard]] inline bool is_empty() const {return _dbm.is_empty();}
+
+        [[nodiscard]] inline bool is_satisfying(dim_t x, dim_t y, bound_t g) const {return _dbm.is_satisfying(x, y, g);}
+        [[nodiscard]] inline bool is_satisfying(const difference_bound_t& constraint) const {return _dbm.is_satisfying(constraint);}
+        [[nodiscard]] inline bool is_satisfying(const std::vector<difference_bound_t>& constraints) const {
+            return _dbm.is_satisfying(constraints);
+        }
+
+        [[nodiscard]] inline relation_t relation(const DBM& dbm) const {return _dbm.relation(dbm);}
+        [[nodiscard]] inline relation_t relation(const DBMView& view) const {return _dbm.relation(view._dbm);}
+        [[nodiscard]] inline bool is_equal(const DBM& dbm) const {return _dbm.is_equal(dbm);}
+        [[nodiscard]] inline bool is_subset(const DBM& dbm) const {return _dbm.is_subset(dbm);}
+        [[nodiscard]] inline bool is_superset(const DBM& dbm) const {return _dbm.is_superset(dbm);}
+        [[nodiscard]] inline bool is_included_lu(const DBM& dbm, const std::vector<val_t>& lower,
+                                                 const std::vector<val_t>& upper) const {
+            return _dbm.is_included_lu(dbm, lower, upper);
+        }
+
+        [[nodiscard]] inline bool is_intersecting(const DBM& dbm) const {return _dbm.is_intersecting(dbm);}
+        [[nodiscard]] inline bool is_unbounded() const {return _dbm.is_unbounded();}
+        [[nodiscard]] inline std::vector<difference_bound_t> minimal_constraints() const {
+            return _dbm.minimal_constraints();
+        }
+        [[nodiscard]] inline uint64_t hash() const {return _dbm.hash();}
+
+        inline void close() {_dbm.close();}
+        inline void close(const std::vector<dim_t>& clocks) {_dbm.close(clocks);}
+
+        inline void future() {_dbm.future();}
+        inline void future(val_t d) {_dbm.future(d);}
+        inline void past() {_dbm.past();}
+        inline void delay(val_t d) {_dbm.delay(d);}
+        inline void interval_delay(val_t lower, val_t upper) {_dbm.interval_delay(lower, upper);}
+
+        inline void subtract(dim_t i, dim_t j, bound_t bound) {_dbm.subtract(i, j, bound);}
+        inline void restrict(dim_t x, dim_t y, bound_t g) {_dbm.restrict(x, y, g);}
+        inline void restrict(const difference_bound_t& constraint) {_dbm.restrict(constraint);}
+        inline void restrict(const std::vector<difference_bound_t>& constraints) {_dbm.restrict(constraints);}
+        inline void free(dim_t x) {_dbm.free(x);}
+        inline void assign(dim_t x, val_t m) {_dbm.assign(x, m);}
+        inline void copy(dim_t x, dim_t y) {_dbm.copy(x, y);}
+        inline void shift(dim_t x, val_t n) {_dbm.shift(x, n);}
+        inline void swap_clocks(dim_t a, dim_t b) {_dbm.swap_clocks(a, b);}
+
+        inline void extrapolate(const std::vector<val_t>& ceiling) {_dbm.extrapolate(ceiling);}
+        inline void extrapolate_diagonal(const std::vector<val_t>& ceiling) {_dbm.extrapolate_diagonal(ceiling);}
+        inline void extrapolate_lu(const std::vector<val_t>& lower, const std::vector<val_t>& upper) {
+            _dbm.extrapolate_lu(lower, upper);
+        }
+        inline void extrapolate_lu_diagonal(const std::vector<val_t>& lower, const std::vector<val_t>& upper) {
+            _dbm.extrapolate_lu_diagonal(lower, upper);
+        }
+        inline void extrapolate(const extrapolation_t& extrapolation) {_dbm.extrapolate(extrapolation);}
+
+        inline void intersection(const DBM& dbm) {_dbm.intersection(dbm);}
+        inline void intersection(const DBMView& view) {_dbm.intersection(view._dbm);}
+
+        friend std::ostream& operator<<(std::ostream& out, const DBMView& view) {return out << view._dbm;}
+    };
+}
+
+#endif //PARDIBAAL_DBMVIEW_H
@@ -33,9 +33,23 @@ namespace pardibaal {
 
     Federation::Federation() : zones{} {}
 
-    Federation::Federation(dim_t dimension) : zones{DBM::zero(dimension)} {}
+    Federation::Federation(const allocator_type& alloc) : zones(alloc) {}
 
-    Federation::Federation(const DBM& dbm) : zones{dbm} {}
+    Federation::Federation(dim_t dimension, const allocator_type& alloc) : zones(alloc) {
+        zones.emplace_back(dimension);
+    }
+
+    Federation::Federation(const DBM& dbm, const allocator_type& alloc) : zones(alloc) {
+        zones.push_back(dbm);
+    }
+
+    Federation::Federation(const Federation& fed, const allocator_type& alloc)
+        : zones(fed.zones, alloc), _max_size(fed._max_size), _is_disjoint(fed._is_disjoint) {}
+
+    Federation::Federation(Federation&& fed, const allocator_type& alloc)
+        : zones(std::move(fed.zones), alloc), _max_size(fed._max_size), _is_disjoint(fed._is_disjoint) {}
+
+    Federation::allocator_type Federation::get_allocator() const {return zones.get_allocator();}
 
     Federation Federation::zero(dim_t dimension) {return Federation(DBM::zero(dimension));}
 
@@ -62,10 +76,17 @@ namespace pardibaal {
         }
 #endif
         auto r = this->approx_relation(dbm);
-        if (r.is_subset() || r.is_equal())
-            *this = Federation(dbm);
-        if (r.is_different())
+        if (r.is_subset() || r.is_equal()) {
+            zones.clear();
+            zones.push_back(dbm);
+            _is_disjoint = true;
+        }
+        if (r.is_different()) {
+            // Once the zones overlap, they are not checked again
+            _is_disjoint = _is_disjoint && not this->is_intersecting(dbm);
             zones.push_back(dbm);
+            enforce_max_size();
+        }
     }
 
     void Federation::add(const Federation& fed) {
@@ -83,6 +104,47 @@ namespace pardibaal {
         this->subtract(constraint._i, constraint._j, constraint._bound);
     }
 
+    // The constraint that is satisfied exactly where c is not
+    static inline difference_bound_t complement(const difference_bound_t& c) {
+        return difference_bound_t(c._j, c._i, bound_t(-c._bound.get_bound(), c._bound.is_non_strict()));
+    }
+
+    /*
+     * The constraints that cut the zone, tightest cut first: the constraint x_i - x_j <= b that keeps the narrowest
+     * range of x_i - x_j in the zone. Successive restriction then shrinks the rest early, so more of the remaining
+     * constraints are implied and give no fragment. The zone must be closed.
+     */
+    static void order_cuts(const DBM& zone, const std::vector<difference_bound_t>& constraints,
+                           std::vector<difference_bound_t>& cuts) {
+        cuts.clear();
+        for (const auto& c : constraints)
+            if (zone.at(c._i, c._j) > c._bound)
+                cuts.push_back(c);
+
+        std::stable_sort(cuts.begin(), cuts.end(), [&zone](const auto& a, const auto& b) {
+            return a._bound + zone.at(a._j, a._i) < b._bound + zone.at(b._j, b._i);
+        });
+    }
+
+    /*
+     * Appends the fragments of rest outside the constraints, which are pairwise disjoint and disjoint from the part of
+     * rest inside them. Rest must be closed and intersect the constraints, so that it is never empty.
+     * Constraints implied by the ones already applied to the rest give no fragment.
+     */
+    static void split(DBM&& rest, const std::vector<difference_bound_t>& constraints,
+                      std::vector<difference_bound_t>& cuts, std::pmr::vector<DBM>& fragments) {
+        order_cuts(rest, constraints, cuts);
+        for (const auto& c : cuts) {
+            if (rest.at(c._i, c._j) <= c._bound) continue;
+
+            DBM z(rest, fragments.get_allocator());
+            z.restrict(complement(c));
+            if (not z.is_empty())
+                fragments.push_back(std::move(z));
+            rest.restrict(c);
+        }
+    }
+
     void Federation::subtract(const DBM& dbm) {
 #ifndef NEXCEPTIONS
         if (!zones.empty()) {
@@ -91,19 +153,35 @@ namespace pardibaal {
                                  " from a federation with dimension: ", dimension());
         }
 #endif
-        auto fed = Federation();
-        for (auto z : zones) {
-            for (dim_t i = 0; i < dimension(); ++i) {
-                for (dim_t j = 0; j < dimension(); ++j) {
-                    // This check ensures that the zone added is non-empty iff it is on max canonical form.
-                    if (z.at(i, j) > dbm.at(i, j)) {
-                        z.restrict(j, i, bound_t(-dbm.at(i, j).get_bound(), dbm.at(i, j).is_non_strict()));
-                        fed.add(z);
-                    }
-                }
+        if (dbm.is_empty()) return;
+
+        // Only computed once a zone intersects dbm
+        std::vector<difference_bound_t> constraints, cuts;
+        bool is_reduced = false;
+        auto fed = Federation(get_allocator());
+        for (const auto& zone : zones) {
+            if (zone.is_empty()) continue;
+            if (not zone.is_intersecting(dbm)) {
+                fed.add(zone);
+                continue;
+            }
+
+            if (not is_reduced) {
+                constraints = dbm.minimal_constraints();
+                is_reduced = true;
+            }
+
+            // Each fragment is the zone outside one constraint of dbm
+            order_cuts(zone, constraints, cuts);
+            for (const auto& c : cuts) {
+                DBM z(zone, get_allocator());
+                z.restrict(complement(c));
+                fed.add(z);
             }
         }
-        *this = fed;
+        zones = std::move(fed.zones);
+        _is_disjoint = fed._is_disjoint;
+        enforce_max_size();
     }
 
     void Federation::subtract(const Federation& fed) {
@@ -111,6 +189,268 @@ namespace pardibaal {
             this->subtract(dbm);
     }
 
+    /*
+     * Each fragment is the rest of the zone outside one constraint of dbm, and the rest is then restricted to that
+     * constraint. The fragments are thereby disjoint from each other and from zone intersect dbm.
+     */
+    void Federation::subtract_disjoint(const DBM& dbm) {
+#ifndef NEXCEPTIONS
+        if (!zones.empty()) {
+            if (dimension() != dbm.dimension())
+                throw base_error("ERROR: Subtracting dbm with dimension: ", dbm.dimension(),
+                                 " from a federation with dimension: ", dimension());
+        }
+#endif
+        if (dbm.is_empty()) return;
+
+        // Only computed once a zone intersects dbm
+        std::vector<difference_bound_t> constraints, cuts;
+        bool is_reduced = false;
+        zone_vector fragments(get_allocator());
+        for (auto& zone : zones) {
+            if (zone.is_empty()) continue;
+
+            // Closes both zones, and a zone outside dbm is kept as it is
+            if (not zone.is_intersecting(dbm)) {
+                fragments.push_back(std::move(zone));
+                continue;
+            }
+
+            if (not is_reduced) {
+                constraints = dbm.minimal_constraints();
+                is_reduced = true;
+            }
+            split(std::move(zone), constraints, cuts, fragments);
+        }
+        zones = std::move(fragments);
+        enforce_max_size();
+    }
+
+    void Federation::subtract_disjoint(const Federation& fed) {
+        for (const auto& dbm : fed)
+            this->subtract_disjoint(dbm);
+    }
+
+    /*
+     * Zones included in a single other zone are removed first, since relation is cheap.
+     * A remaining zone is included in the union of the others iff subtracting the zones it intersects leaves nothing.
+     */
+    void Federation::reduce() {
+        make_consistent();
+
+        // A non-empty zone is not included in the union of zones it is disjoint from
+        if (_is_disjoint) return;
+        remove_included();
+
+        for (size_t i = 0; i < zones.size();) {
+            Federation rest(zones[i], get_allocator());
+            for (size_t j = 0; j < zones.size() && not rest.zones.empty(); ++j)
+                if (j != i && zones[i].is_intersecting(zones[j]))
+                    rest.subtract(zones[j]);
+
+            if (rest.zones.empty())
+                zones.erase(zones.begin() + i);
+            else
+                ++i;
+        }
+    }
+
+    // make_consistent closes all zones, which is_union relies on
+    void Federation::merge() {
+        make_consistent();
+        if (not _is_disjoint)
+            remove_included();
+
+        for (bool is_merged = true; is_merged;) {
+            is_merged = false;
+            for (size_t i = 0; i < zones.size(); ++i) {
+                for (size_t j = i + 1; j < zones.size(); ++j) {
+                    DBM hull(zones[i], get_allocator());
+                    hull.convex_union(zones[j]);
+                    if (not is_union(hull, zones[i], zones[j]))
+                        continue;
+
+                    replace_by_hull(i, j, std::move(hull));
+                    is_merged = true;
+                    break;
+                }
+                if (is_merged) break;
+            }
+        }
+
+        reduce();
+    }
+
+    void Federation::replace_by_hull(size_t i, size_t j, DBM&& hull) {
+        zones.erase(zones.begin() + j);
+        zones.erase(zones.begin() + i);
+
+        // The hull may also include other zones than the pair
+        std::erase_if(zones, [&hull](const DBM& z) {
+            const relation_t r = z.relation(hull);
+            return r.is_subset() || r.is_equal();
+        });
+        zones.push_back(std::move(hull));
+    }
+
+    /*
+     * How much the convex union of a and b adds to them: first the number of bounds that become unbounded,
+     * then the sum of how much the other bounds are relaxed. a and b must be closed.
+     */
+    static inline std::pair<uint64_t, uint64_t> hull_cost(const DBM& a, const DBM& b) {
+        std::pair<uint64_t, uint64_t> cost{0, 0};
+        for (dim_t i = 0; i < a.dimension(); ++i) {
+            for (dim_t j = 0; j < a.dimension(); ++j) {
+                const bound_t x = a.at(i, j), y = b.at(i, j);
+                if (x.is_inf() != y.is_inf())
+                    ++cost.first;
+                else
+                    cost.second += x < y ? (uint64_t) y.get_raw() - x.get_raw() : (uint64_t) x.get_raw() - y.get_raw();
+            }
+        }
+        return cost;
+    }
+
+    void Federation::enforce_max_size() {
+        if (_max_size == 0 || zones.size() <= _max_size)
+            return;
+
+        // Closes the zones, which hull_cost relies on
+        make_consistent();
+
+        while (zones.size() > _max_size) {
+            size_t best_i = 0, best_j = 1;
+            auto best_cost = hull_cost(zones[0], zones[1]);
+            for (size_t i = 0; i < zones.size(); ++i) {
+                for (size_t j = i + 1; j < zones.size(); ++j) {
+                    const auto cost = hull_cost(zones[i], zones[j]);
+                    if (cost < best_cost) {
+                        best_cost = cost;
+                        best_i = i;
+                        best_j = j;
+                    }
+                }
+            }
+
+            DBM hull(zones[best_i], get_allocator());
+            hull.convex_union(zones[best_j]);
+            replace_by_hull(best_i, best_j, std::move(hull));
+            _is_disjoint = false;
+        }
+    }
+
+    void Federation::set_max_size(dim_t max_size) {
+        _max_size = max_size;
+        enforce_max_size();
+    }
+
+    void Federation::remove_included() {
+        for (size_t i = 0; i < zones.size();) {
+            bool is_included = false;
+            for (size_t j = 0; j < zones.size() && not is_included; ++j) {
+                if (i == j) continue;
+                const relation_t r = zones[i].relation(zones[j]);
+                is_included = r.is_subset() || r.is_equal();
+            }
+
+            if (is_included)
+                zones.erase(zones.begin() + i);
+            else
+                ++i;
+        }
+    }
+
+    /*
+     * hull \ a is the union of the fragments of hull outside each constraint of a that is tighter than in the hull,
+     * so hull is the union of a and b iff b includes every such fragment.
+     */
+    bool Federation::is_union(const DBM& hull, const DBM& a, const DBM& b) {
+        for (dim_t i = 0; i < hull.dimension(); ++i) {
+            for (dim_t j = 0; j < hull.dimension(); ++j) {
+                if (a.at(i, j) >= hull.at(i, j)) continue;
+
+                DBM fragment(hull);
+                fragment.restrict(complement(difference_bound_t(i, j, a.at(i, j))));
+                if (fragment.is_empty()) continue;
+
+                const relation_t r = fragment.relation(b);
+                if (not r.is_subset() && not r.is_equal())
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+     * The fragments of dbm not yet covered are kept on a stack, each with the index of the next zone that may cover it.
+     * A fragment is split by the first such zone it intersects, and the fragments outside that zone move on to the
+     * next zones. As soon as no zone intersects a fragment, dbm is not included, and the rest is never split.
+     */
+    bool Federation::is_including(const DBM& dbm) const {
+#ifndef NEXCEPTIONS
+        if (!zones.empty()) {
+            if (dimension() != dbm.dimension())
+                throw base_error("ERROR: Testing inclusion of dbm with dimension: ", dbm.dimension(),
+                                 " in a federation with dimension: ", dimension());
+        }
+#endif
+        if (dbm.is_empty()) return true;
+        if (zones.empty() || dimension() != dbm.dimension()) return false;
+
+        for (const auto& zone : zones) {
+            const relation_t r = dbm.relation(zone);
+            if (r.is_subset() || r.is_equal())
+                return true;
+        }
+
+        // The minimal constraints of a zone are only computed once it splits a fragment
+        std::vector<std::vector<difference_bound_t>> constraints(zones.size());
+        std::vector<bool> is_reduced(zones.size(), false);
+        std::vector<difference_bound_t> cuts;
+        zone_vector fragments(get_allocator());
+        std::vector<std::pair<DBM, size_t>> uncovered;
+        uncovered.emplace_back(DBM(dbm, get_allocator()), 0);
+
+        while (not uncovered.empty()) {
+            auto [fragment, k] = std::move(uncovered.back());
+            uncovered.pop_back();
+
+            while (k < zones.size() && not zones[k].is_intersecting(fragment))
+                ++k;
+            if (k == zones.size())
+                return false;
+
+            const relation_t r = fragment.relation(zones[k]);
+            if (r.is_subset() || r.is_equal())
+                continue;
+
+            if (not is_reduced[k]) {
+                constraints[k] = zones[k].minimal_constraints();
+                is_reduced[k] = true;
+            }
+            fragments.clear();
+            split(std::move(fragment), constraints[k], cuts, fragments);
+            for (auto& f : fragments)
+                uncovered.emplace_back(std::move(f), k + 1);
+        }
+
+        return true;
+    }
+
+    bool Federation::is_included(const DBM& dbm) const {
+#ifndef NEXCEPTIONS
+        if (!zones.empty()) {
+            if (dimension() != dbm.dimension())
+                throw base_error("ERROR: Testing inclusion of a federation with dimension: ", dimension(),
+                                 " in dbm with dimension: ", dbm.dimension());
+        }
+#endif
+        return std::all_of(zones.begin(), zones.end(), [&dbm](const DBM& zone) {
+            const relation_t r = zone.relation(dbm);
+            return r.is_subset() || r.is_equal();
+        });
+    }
+
     void Federation::remove(dim_t index) {
 #ifndef NEXCEPTIONS
         if (index >= zones.size())
@@ -155,11 +495,24 @@ namespace pardibaal {
         return true;
     }
 
+    // A dbm of another dimension is different from a non-empty federation, even if one of them is empty
+    static inline bool is_other_dimension(const Federation& fed, const DBM& dbm) {
+        return fed.size() != 0 && fed.dimension() != dbm.dimension();
+    }
+
     template<bool is_exact>
     relation_t Federation::relation(const DBM& dbm) const {
-        if constexpr(is_exact)
-            return this->relation<true>(Federation(dbm));
-        
+        if constexpr(is_exact) {
+            if (is_other_dimension(*this, dbm))
+                return relation_t::different();
+
+            const bool is_included = this->is_included(dbm), is_including = this->is_including(dbm);
+            if (is_included && is_including) return relation_t::equal();
+            if (is_included)                 return relation_t::subset();
+            if (is_including)                return relation_t::superset();
+            return relation_t::different();
+        }
+
         if (this->is_empty())
             return dbm.is_empty() ? relation_t::equal() : relation_t::subset();
         if (dbm.is_empty())
@@ -199,20 +552,15 @@ namespace pardibaal {
 
         if constexpr(is_exact) {
             
-            auto fed1 = *this;
-            auto fed2 = fed;
-
-            fed1.subtract(fed);
-            fed2.subtract(*this);
-            
-            if (fed1.is_empty()) {
-                if (fed2.is_empty())
-                    return relation_t::equal();
-                return relation_t::subset();
-            } 
-            if (fed2.is_empty())
-                return relation_t::superset();
-
+            // Each side is included in the other iff each of its zones is, which stops at the first zone that is not
+            const bool is_included = std::all_of(zones.begin(), zones.end(),
+                                                 [&fed](const DBM& z) {return fed.is_including(z);});
+            const bool is_including = std::all_of(fed.zones.begin(), fed.zones.end(),
+                                                  [this](const DBM& z) {return this->is_including(z);});
+
+            if (is_included && is_including) return relation_t::equal();
+            if (is_included)                 return relation_t::subset();
+            if (is_including)                return relation_t::superset();
             return relation_t::different();
 
         } else {
@@ -256,8 +604,11 @@ namespace pardibaal {
         return relation_t::different();
     }
 
+    // The exact tests check the cheap inclusion in dbm first, and only check the inclusion of dbm if needed
     template<bool is_exact>
     bool Federation::is_equal(const DBM& dbm) const {
+        if constexpr(is_exact)
+            return not is_other_dimension(*this, dbm) && this->is_included(dbm) && this->is_including(dbm);
         return this->relation<is_exact>(dbm).is_equal();
     }
 
@@ -268,6 +619,8 @@ namespace pardibaal {
 
     template<bool is_exact>
     bool Federation::is_subset(const DBM& dbm) const {
+        if constexpr(is_exact)
+            return not is_other_dimension(*this, dbm) && this->is_included(dbm) && not this->is_including(dbm);
         return this->relation<is_exact>(dbm).is_subset();
     }
 
@@ -278,6 +631,8 @@ namespace pardibaal {
 
     template<bool is_exact>
     bool Federation::is_superset(const DBM& dbm) const {
+        if constexpr(is_exact)
+            return not is_other_dimension(*this, dbm) && not this->is_included(dbm) && this->is_including(dbm);
         return this->relation<is_exact>(dbm).is_superset();
     }
 
@@ -325,14 +680,17 @@ namespace pardibaal {
     }
 
     void Federation::future() {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.future();
     }
 
     void Federation::future(val_t d) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.future(d);
     }
 
     void Federation::past() {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.past();
     }
 
@@ -341,6 +699,7 @@ namespace pardibaal {
     }
 
     void Federation::interval_delay(val_t lower, val_t upper) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.interval_delay(lower, upper);
     }
 
@@ -360,62 +719,80 @@ namespace pardibaal {
     }
 
     void Federation::free(dim_t x) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.free(x);
     }
 
     void Federation::assign(dim_t x, val_t m) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.assign(x, m);
         make_consistent();
     }
 
     void Federation::copy(dim_t x, dim_t y) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.copy(x, y);
     }
 
     void Federation::shift(dim_t x, val_t n) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.shift(x, n);
         make_consistent();
     }
 
     void Federation::extrapolate(const std::vector<val_t>& ceiling) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.extrapolate(ceiling);
     }
 
     void Federation::extrapolate_diagonal(const std::vector<val_t>& ceiling) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.extrapolate_diagonal(ceiling);
     }
 
     void Federation::extrapolate_lu(const std::vector<val_t>& lower, const std::vector<val_t>& upper) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.extrapolate_lu(lower, upper);
     }
 
     void Federation::extrapolate_lu_diagonal(const std::vector<val_t>& lower, const std::vector<val_t>& upper) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.extrapolate_lu_diagonal(lower, upper);
     }
 
+    void Federation::extrapolate(const extrapolation_t& extrapolation) {
+        mark_overlapping();
+        for (DBM& dbm : zones) dbm.extrapolate(extrapolation);
+    }
+
     void Federation::intersection(const DBM& dbm) {
-        auto fed = Federation();
+        auto fed = Federation(get_allocator());
         for (auto& z : zones) {
             z.intersection(dbm);
             fed.add(z);
         }
 
-        *this = std::move(fed);
+        // The zones only shrink, so disjoint zones stay disjoint
+        zones = std::move(fed.zones);
+        _is_disjoint = _is_disjoint || fed._is_disjoint;
     }
 
     void Federation::intersection(const Federation& fed) {
-        auto union_fed = Federation();
-        auto tmp_fed = Federation();
+        auto union_fed = Federation(get_allocator());
+        auto tmp_fed = Federation(get_allocator());
         for (const auto& z : fed) {
             tmp_fed = *this;
             tmp_fed.intersection(z);
             union_fed.add(tmp_fed);
         }
 
-        *this = std::move(union_fed);
+        zones = std::move(union_fed.zones);
+        _is_disjoint = union_fed._is_disjoint;
+        enforce_max_size();
     }
 
     void Federation::remove_clock(dim_t c) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.remove_clock(c);
     }
 
@@ -430,6 +807,7 @@ namespace pardibaal {
     std::vector<dim_t> Federation::resize(const std::vector<bool>& src_bits, const std::vector<bool>& dst_bits) {
         bool first = true;
         std::vector<dim_t> rtn;
+        mark_overlapping();
 
         for (DBM& dbm : zones) {
             if (first) {
@@ -443,6 +821,7 @@ namespace pardibaal {
     }
 
     void Federation::reorder(const std::vector<dim_t>& order, dim_t new_size) {
+        mark_overlapping();
         for (DBM& dbm : zones) dbm.reorder(order, new_size);
     }
 
@@ -24,6 +24,7 @@
 
 #include <vector>
 #include <ostream>
+#include <memory_resource>
 
 #include "difference_bound_t.h"
 #include "bound_t.h"
@@ -33,25 +34,62 @@ namespace pardibaal {
 
     class Federation {
 
-        using zone_vector = std::vector<DBM>;
+        using zone_vector = std::pmr::vector<DBM>;
 
         zone_vector zones;
 
+        // The maximal number of zones, or 0 if there is no limit
+        dim_t _max_size = 0;
+
+        // Whether the zones are known to be pairwise disjoint
+        bool _is_disjoint = true;
+
+        // After operations that may make disjoint zones overlap
+        inline void mark_overlapping() {_is_disjoint = zones.size() <= 1;}
+
         /**
          * Makes the federation consistent, by deleting all empty zones.
          * A federation is consistent if all zones are nonempty.
          */
         void make_consistent();
 
+        // Removes the zones included in (or equal to) another single zone
+        void remove_included();
+
+        // Whether hull, the convex union of a and b, is their union. a must be closed.
+        static bool is_union(const DBM& hull, const DBM& a, const DBM& b);
+
+        // Replaces the zones at index i < j, and the zones included in hull, by hull
+        void replace_by_hull(size_t i, size_t j, DBM&& hull);
+
+        // Replaces the closest pairs of zones by their convex union until there are at most max_size() zones
+        void enforce_max_size();
+
     public:
+        // The zones, and the bounds of each zone, are allocated through this allocator
+        using allocator_type = zone_vector::allocator_type;
+
         // Creates an empty federation with no zones
         Federation();
 
+        // Creates an empty federation that allocates from the given memory resource
+        explicit Federation(const allocator_type& alloc);
+
         // Creates a federation with a single zone where all clocks are zero
-        Federation(dim_t dimension);
+        Federation(dim_t dimension, const allocator_type& alloc = {});
 
         // Creates a federation with a given zone
-        Federation(const DBM& dbm);
+        Federation(const DBM& dbm, const allocator_type& alloc = {});
+
+        Federation(const Federation& fed) = default;
+        Federation(Federation&& fed) noexcept = default;
+        Federation(const Federation& fed, const allocator_type& alloc);
+        Federation(Federation&& fed, const allocator_type& alloc);
+
+        Federation& operator=(const Federation& fed) = default;
+        Federation& operator=(Federation&& fed) = default;
+
+        [[nodiscard]] allocator_type get_allocator() const;
 
         // Returns a federation with single zero bounded dbm
         static Federation zero(dim_t dimension);
@@ -100,8 +138,47 @@ namespace pardibaal {
          */
         void subtract(const Federation& fed);
 
+        /**
+         * Subtract a dbm from this federation, splitting each zone into pairwise disjoint fragments.
+         * The fragments are appended without inclusion checks, so subtraction is linear in the number of fragments,
+         * but fragments of different zones may be redundant.
+         * If the zones were disjoint, they still are (see is_disjoint).
+         * @param dbm to be subtracted.
+         */
+        void subtract_disjoint(const DBM& dbm);
+
+        /**
+         * Subtract a federation from this federation, see subtract_disjoint(const DBM&).
+         * @param fed The federation to be subtracted.
+         */
+        void subtract_disjoint(const Federation& fed);
+
         void remove(dim_t index);
 
+        /**
+         * Removes the empty zones and the zones included in the union of the others.
+         * The union of the zones is unchanged.
+         */
+        void reduce();
+
+        /**
+         * Replaces pairs of zones whose convex union is exactly their union by that zone (see DBM::convex_union),
+         * until no pair can be merged, and then reduces the federation.
+         * The union of the zones is unchanged.
+         */
+        void merge();
+
+        /**
+         * Limits the number of zones, for over-approximating analyses with predictable memory and time per federation.
+         * Whenever add, subtract or intersection leaves more than max_size zones, the pair of zones whose convex union
+         * (see DBM::convex_union) adds the least is replaced by it, until there are at most max_size zones.
+         * The federation is then an over-approximation of the exact result.
+         * Exact relations are computed without the limit, but relations of an over-approximation are approximate.
+         * @param max_size maximal number of zones, or 0 for no limit (the default). Applied immediately.
+         */
+        void set_max_size(dim_t max_size);
+
+        [[nodiscard]] inline dim_t max_size() const {return _max_size;}
 
         /**
          * Number of DBMs stored in the federation
@@ -118,6 +195,13 @@ namespace pardibaal {
          */
         [[nodiscard]] dim_t dimension() const;
 
+        /**
+         * Whether the zones are known to be pairwise disjoint.
+         * Operations that only shrink or translate the zones, and subtract_disjoint, keep the zones disjoint.
+         * A false result only means that disjointness is not known.
+         */
+        [[nodiscard]] inline bool is_disjoint() const {return _is_disjoint;}
+
         /**
          * @return true if the size is 0 or all zones are empty
          */
@@ -135,6 +219,21 @@ namespace pardibaal {
         [[nodiscard]] bool is_satisfying(const difference_bound_t& constraint) const;
         [[nodiscard]] bool is_satisfying(const std::vector<difference_bound_t>& constraints) const;
 
+        /**
+         * Exact test of whether dbm is included in (a subset of or equal to) the union of the zones.
+         * dbm is split by the zones it intersects, one zone at a time, and the test returns false as soon as a
+         * fragment intersects none of the remaining zones, without computing the rest of the difference.
+         * @return true if dbm is included in this
+         */
+        [[nodiscard]] bool is_including(const DBM& dbm) const;
+
+        /**
+         * Exact test of whether the union of the zones is included in (a subset of or equal to) dbm,
+         * which holds iff every zone is.
+         * @return true if this is included in dbm
+         */
+        [[nodiscard]] bool is_included(const DBM& dbm) const;
+
         /**
          * Relation between this and a dbm.
          * The non-exact relation is an under-approximation.
@@ -272,6 +371,7 @@ namespace pardibaal {
         void extrapolate_diagonal(const std::vector<val_t>& ceiling);
         void extrapolate_lu(const std::vector<val_t>& lower, const std::vector<val_t>& upper);
         void extrapolate_lu_diagonal(const std::vector<val_t>& lower, const std::vector<val_t>& upper);
+        void extrapolate(const extrapolation_t& extrapolation);
 
         void intersection(const DBM& dbm);
         void intersection(const Federation& fed);
@@ -0,0 +1,124 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ZoneStore.h"
+
+namespace pardibaal {
+
+    void ZoneStore::bucket_t::remove(size_t index) {
+        if (index + 1 != zones.size()) {
+            hashes[index] = hashes.back();
+            zones[index] = std::move(zones.back());
+        }
+        hashes.pop_back();
+        zones.pop_back();
+    }
+
+    ZoneStore::ZoneStore(const allocator_type& alloc) : _buckets(alloc) {}
+
+    ZoneStore::allocator_type ZoneStore::get_allocator() const {return _buckets.get_allocator();}
+
+    /*
+     * Since the stored zones are pairwise incomparable, the new zone is either included in a stored zone,
+     * or it may include some of them, but not both. So included zones are removed while looking for a cover.
+     */
+    template<typename Zone>
+    bool ZoneStore::insert_zone(key_type key, Zone&& zone) {
+        if (zone.is_empty()) return false;
+
+        const uint64_t hash = zone.hash();
+        auto it = _buckets.find(key);
+        if (it == _buckets.end())
+            it = _buckets.emplace(key, bucket_t(get_allocator())).first;
+        bucket_t& bucket = it->second;
+
+        for (size_t i = 0; i < bucket.hashes.size(); ++i)
+            if (bucket.hashes[i] == hash && bucket.zones[i].is_equal(zone))
+                return false;
+
+        for (size_t i = 0; i < bucket.zones.size();) {
+            const relation_t r = zone.relation(bucket.zones[i]);
+            if (r.is_subset() || r.is_equal())
+                return false;
+            if (r.is_superset()) {
+                bucket.remove(i);
+                --_size;
+            } else {
+                ++i;
+            }
+        }
+
+        bucket.hashes.push_back(hash);
+        bucket.zones.push_back(std::forward<Zone>(zone));
+        ++_size;
+        return true;
+    }
+
+    bool ZoneStore::insert(key_type key, const DBM& zone) {return this->insert_zone(key, zone);}
+
+    bool ZoneStore::insert(key_type key, DBM&& zone) {return this->insert_zone(key, std::move(zone));}
+
+    bool ZoneStore::is_covered(key_type key, const DBM& zone) const {
+        if (zone.is_empty()) return true;
+
+        auto it = _buckets.find(key);
+        if (it == _buckets.end()) return false;
+        const bucket_t& bucket = it->second;
+
+        const uint64_t hash = zone.hash();
+        for (size_t i = 0; i < bucket.hashes.size(); ++i)
+            if (bucket.hashes[i] == hash && bucket.zones[i].is_equal(zone))
+                return true;
+
+        for (const DBM& stored : bucket.zones) {
+            const relation_t r = zone.relation(stored);
+            if (r.is_subset() || r.is_equal())
+                return true;
+        }
+
+        return false;
+    }
+
+    std::span<const DBM> ZoneStore::zones(key_type key) const {
+        auto it = _buckets.find(key);
+        if (it == _buckets.end()) return {};
+        return {it->second.zones.data(), it->second.zones.size()};
+    }
+
+    void ZoneStore::erase(key_type key) {
+        auto it = _buckets.find(key);
+        if (it == _buckets.end()) return;
+        _size -= it->second.zones.size();
+        _buckets.erase(it);
+    }
+
+    void ZoneStore::clear() {
+        _buckets.clear();
+        _size = 0;
+    }
+
+    size_t ZoneStore::size() const {return _size;}
+
+    size_t ZoneStore::number_of_keys() const {return _buckets.size();}
+
+    bool ZoneStore::is_empty() const {return _size == 0;}
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARDIBAAL_ZONESTORE_H
+#define PARDIBAAL_ZONESTORE_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <memory_resource>
+#include <unordered_map>
+
+#include "DBM.h"
+
+namespace pardibaal {
+
+    /**
+     * Zones grouped by a user-supplied key, eg. a hash of the discrete state, as in a passed or waiting list.
+     * The zones of a key are kept pairwise incomparable: a zone included in a stored zone is not inserted,
+     * and stored zones included in an inserted zone are removed.
+     * Exact duplicates, the most common covered zones, are found by comparing the hashes (see DBM::hash)
+     * before the bounds are compared.
+     */
+    class ZoneStore {
+    public:
+        using key_type = uint64_t;
+
+        // The buckets, the zones, and the bounds of each zone are allocated through this allocator
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    private:
+        struct bucket_t {
+            using allocator_type = ZoneStore::allocator_type;
+
+            std::pmr::vector<uint64_t> hashes;
+            std::pmr::vector<DBM> zones;
+
+            explicit bucket_t(const allocator_type& alloc) : hashes(alloc), zones(alloc) {}
+            bucket_t(bucket_t&& bucket, const allocator_type& alloc)
+                : hashes(std::move(bucket.hashes), alloc), zones(std::move(bucket.zones), alloc) {}
+
+            // Removes the zone at index by moving the last zone into its place
+            void remove(size_t index);
+        };
+
+        std::pmr::unordered_map<key_type, bucket_t> _buckets;
+        size_t _size = 0;
+
+        template<typename Zone>
+        bool insert_zone(key_type key, Zone&& zone);
+
+    public:
+        ZoneStore() = default;
+
+        // Creates an empty store that allocates from the given memory resource
+        explicit ZoneStore(const allocator_type& alloc);
+
+        [[nodiscard]] allocator_type get_allocator() const;
+
+        /**
+         * Adds a zone to the key, unless it is empty or included in a zone stored for the key.
+         * Zones stored for the key that are included in the new zone are removed.
+         * @param key the discrete state of the zone
+         * @param zone the zone to add
+         * @return true if the zone was added, false if it was already covered
+         */
+        bool insert(key_type key, const DBM& zone);
+        bool insert(key_type key, DBM&& zone);
+
+        /**
+         * Checks whether a zone is covered by the store, ie. empty or included in a zone stored for the key.
+         * @return true if insert would not add the zone
+         */
+        [[nodiscard]] bool is_covered(key_type key, const DBM& zone) const;
+
+        /** The zones stored for a key, in no particular order. Invalidated by insert and erase. */
+        [[nodiscard]] std::span<const DBM> zones(key_type key) const;
+
+        /** Removes all zones of a key */
+        void erase(key_type key);
+
+        void clear();
+
+        /** Total number of zones stored for all keys */
+        [[nodiscard]] size_t size() const;
+
+        /** Number of keys with at least one zone */
+        [[nodiscard]] size_t number_of_keys() const;
+
+        [[nodiscard]] bool is_empty() const;
+    };
+}
+
+#endif //PARDIBAAL_ZONESTORE_H
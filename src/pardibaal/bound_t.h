@@ -25,68 +25,117 @@
 
 #include <ostream>
 #include <cinttypes>
+#include <limits>
+#include <cassert>
 
 
 namespace pardibaal {
     using dim_t = uint32_t;
     using val_t = int32_t;
 
+    /**
+     * Packed representation of a bound: the value shifted left by one with the
+     * strictness in the lowest bit (0 for strict, 1 for non-strict).
+     * Ordering of bounds is then the ordering of the raw integers.
+     */
+    using raw_t = int32_t;
+
     enum strict_e {STRICT, NON_STRICT};
 
     struct bound_t {
-    private:
-        val_t _n = 0;
-        bool _strict = false,
-             _inf = false;
-
-        constexpr bound_t(val_t n, bool strict, bool inf) : _n(n), _strict(strict), _inf(inf){};
     public:
-        constexpr bound_t(){};
-        constexpr bound_t(val_t n, strict_e strictness) : _n(n) {_strict = strictness == STRICT ? true : false;}
-        constexpr bound_t(val_t n, bool strict) : _n(n), _strict(strict) {}
-
-        [[nodiscard]] static constexpr bound_t strict(val_t n)     {return bound_t(n, true,  false);}
-        [[nodiscard]] static constexpr bound_t non_strict(val_t n) {return bound_t(n, false, false);}
-        [[nodiscard]] static constexpr bound_t inf()               {return bound_t(0, true,  true);}
-        [[nodiscard]] static constexpr bound_t le_zero()           {return bound_t(0, false, false);}
-        [[nodiscard]] static constexpr bound_t lt_zero()           {return bound_t(0, true,  false);}
+        /**
+         * Largest absolute value of a bound. The value is halved by the packing, so finite bounds lie strictly
+         * within +-INF_VALUE, and bound_t::strict(INF_VALUE) is infinity.
+         * -INF_VALUE can therefore be used as the constant of a clock without constants in the extrapolations.
+         * The sum of two finite bounds must also lie within +-INF_VALUE. This is only checked (by assert) in
+         * debug builds, the closure does not saturate.
+         */
+        static constexpr val_t INF_VALUE = (1 << 30) - 1;
 
-        [[nodiscard]] inline val_t get_bound()    const {return this->_n;}
-        [[nodiscard]] inline bool is_strict()     const {return this->_strict;}
-        [[nodiscard]] inline bool is_non_strict() const {return not this->_strict;}
-        [[nodiscard]] inline bool is_inf()        const {return this->_inf;}
+    private:
+        // Infinity is the largest strict raw value, ie. the encoding of bound_t::strict(INF_VALUE)
+        static constexpr raw_t INF_RAW = std::numeric_limits<raw_t>::max() & ~1;
 
-        [[nodiscard]] static const bound_t& max(const bound_t &a, const bound_t &b);
-        [[nodiscard]] static bound_t max(bound_t &&a, bound_t &&b);
-        [[nodiscard]] static bound_t max(const bound_t &a, bound_t &&b);
-        [[nodiscard]] static bound_t max(bound_t &&a, const bound_t &b);
+        raw_t _raw = 1;
 
-        [[nodiscard]] static const bound_t& min(const bound_t &a, const bound_t &b);
-        [[nodiscard]] static bound_t min(bound_t &&a, bound_t &&b);
-        [[nodiscard]] static bound_t min(const bound_t &a, bound_t &&b);
-        [[nodiscard]] static bound_t min(bound_t &&a, const bound_t &b);
+        static constexpr raw_t encode(val_t n, bool strict) {
+            assert(-INF_VALUE <= n && n <= INF_VALUE && (strict || n < INF_VALUE));
+            return (raw_t)((uint32_t) n << 1) | (strict ? 0 : 1);
+        }
 
-        [[nodiscard]] bound_t operator+(bound_t rhs) const;
-        [[nodiscard]] bound_t operator+(val_t rhs) const;
+        // Sums are computed on unsigned integers such that an overflow is caught by the assert rather than being UB
+        static constexpr raw_t checked_sum(raw_t a, raw_t b) {
+            assert(-(int64_t) INF_RAW <= (int64_t) a + b && (int64_t) a + b < (int64_t) INF_RAW);
+            return (raw_t)((uint32_t) a + (uint32_t) b);
+        }
 
-        [[nodiscard]] bound_t operator-(val_t rhs) const;
+        struct raw_tag {};
+        constexpr bound_t(raw_t raw, raw_tag) : _raw(raw) {};
+    public:
+        constexpr bound_t(){};
+        constexpr bound_t(val_t n, strict_e strictness) : _raw(encode(n, strictness == STRICT)) {}
+        constexpr bound_t(val_t n, bool strict) : _raw(encode(n, strict)) {}
+
+        [[nodiscard]] static constexpr bound_t strict(val_t n)     {return bound_t(encode(n, true), raw_tag{});}
+        [[nodiscard]] static constexpr bound_t non_strict(val_t n) {return bound_t(encode(n, false), raw_tag{});}
+        [[nodiscard]] static constexpr bound_t inf()               {return bound_t(INF_RAW, raw_tag{});}
+        [[nodiscard]] static constexpr bound_t le_zero()           {return bound_t(encode(0, false), raw_tag{});}
+        [[nodiscard]] static constexpr bound_t lt_zero()           {return bound_t(encode(0, true), raw_tag{});}
+
+        /**
+         * Construct a bound directly from its packed representation.
+         * @param raw value as returned by get_raw()
+         */
+        [[nodiscard]] static constexpr bound_t from_raw(raw_t raw) {return bound_t(raw, raw_tag{});}
+
+        [[nodiscard]] inline raw_t get_raw()      const {return this->_raw;}
+        [[nodiscard]] inline val_t get_bound()    const {return this->is_inf() ? 0 : this->_raw >> 1;}
+        [[nodiscard]] inline bool is_strict()     const {return (this->_raw & 1) == 0;}
+        [[nodiscard]] inline bool is_non_strict() const {return (this->_raw & 1) != 0;}
+        [[nodiscard]] inline bool is_inf()        const {return this->_raw == INF_RAW;}
+
+        [[nodiscard]] static inline const bound_t& max(const bound_t &a, const bound_t &b) {return a < b ? b : a;}
+        [[nodiscard]] static inline bound_t max(bound_t &&a, bound_t &&b) {return max(a, b);}
+        [[nodiscard]] static inline bound_t max(const bound_t &a, bound_t &&b) {return max(a, b);}
+        [[nodiscard]] static inline bound_t max(bound_t &&a, const bound_t &b) {return max(a, b);}
+
+        [[nodiscard]] static inline const bound_t& min(const bound_t &a, const bound_t &b) {return a <= b ? a : b;}
+        [[nodiscard]] static inline bound_t min(bound_t &&a, bound_t &&b) {return min(a, b);}
+        [[nodiscard]] static inline bound_t min(const bound_t &a, bound_t &&b) {return min(a, b);}
+        [[nodiscard]] static inline bound_t min(bound_t &&a, const bound_t &b) {return min(a, b);}
+
+        // Adding the raw values doubles the strictness bit, so one is subtracted if either bound is non-strict.
+        [[nodiscard]] inline bound_t operator+(bound_t rhs) const {
+            if (this->is_inf() || rhs.is_inf())
+                return bound_t::inf();
+            return bound_t(checked_sum(this->_raw, rhs._raw - ((this->_raw | rhs._raw) & 1)), raw_tag{});
+        }
+
+        [[nodiscard]] inline bound_t operator+(val_t rhs) const {
+            return this->is_inf() ? *this : bound_t(checked_sum(this->_raw, encode(rhs, true)), raw_tag{});
+        }
+
+        [[nodiscard]] inline bound_t operator-(val_t rhs) const {
+            return this->is_inf() ? *this : bound_t(checked_sum(this->_raw, encode(-rhs, true)), raw_tag{});
+        }
 
         [[nodiscard]] bound_t operator*(val_t rhs) const;
 
-        [[nodiscard]] bool operator<(bound_t rhs) const;
-        [[nodiscard]] bool operator==(bound_t rhs) const;
+        [[nodiscard]] inline bool operator<(bound_t rhs)  const {return this->_raw <  rhs._raw;}
+        [[nodiscard]] inline bool operator==(bound_t rhs) const {return this->_raw == rhs._raw;}
 
-        [[nodiscard]] bool operator!=(bound_t rhs) const;
-        [[nodiscard]] bool operator>(bound_t rhs) const;
-        [[nodiscard]] bool operator>=(bound_t rhs) const;
-        [[nodiscard]] bool operator<=(bound_t rhs) const;
+        [[nodiscard]] inline bool operator!=(bound_t rhs) const {return this->_raw != rhs._raw;}
+        [[nodiscard]] inline bool operator>(bound_t rhs)  const {return this->_raw >  rhs._raw;}
+        [[nodiscard]] inline bool operator>=(bound_t rhs) const {return this->_raw >= rhs._raw;}
+        [[nodiscard]] inline bool operator<=(bound_t rhs) const {return this->_raw <= rhs._raw;}
 
-        [[nodiscard]] bool operator==(val_t rhs) const;
-        [[nodiscard]] bool operator!=(val_t rhs) const;
-        [[nodiscard]] bool operator<(val_t rhs) const;
-        [[nodiscard]] bool operator>(val_t rhs) const;
-        [[nodiscard]] bool operator<=(val_t rhs) const;
-        [[nodiscard]] bool operator>=(val_t rhs) const;
+        [[nodiscard]] inline bool operator==(val_t rhs) const {return *this == bound_t::non_strict(rhs);}
+        [[nodiscard]] inline bool operator!=(val_t rhs) const {return *this != bound_t::non_strict(rhs);}
+        [[nodiscard]] inline bool operator<(val_t rhs)  const {return *this <  bound_t::non_strict(rhs);}
+        [[nodiscard]] inline bool operator>(val_t rhs)  const {return *this >  bound_t::non_strict(rhs);}
+        [[nodiscard]] inline bool operator<=(val_t rhs) const {return *this <= bound_t::non_strict(rhs);}
+        [[nodiscard]] inline bool operator>=(val_t rhs) const {return *this >= bound_t::non_strict(rhs);}
 
         friend std::ostream& operator<<(std::ostream& out, const bound_t& bound);
 
@@ -100,6 +149,8 @@ namespace pardibaal {
     [[nodiscard]] bound_t operator-(val_t val, bound_t bound);
     [[nodiscard]] bound_t operator*(val_t val, bound_t bound);
     std::ostream& operator<<(std::ostream& out, const bound_t& bound);
+
+    static_assert(sizeof(bound_t) == sizeof(raw_t), "bound_t must be a single packed word");
 }
 
 #endif //PARDIBAAL_BOUND_T_H
@@ -23,18 +23,128 @@
 #include <vector>
 #include <ostream>
 #include <iomanip>
+#include <algorithm>
 
 #include "bounds_table_t.h"
 #include "bound_t.h"
 #include "errors.h"
 
 namespace pardibaal {
-    bounds_table_t::bounds_table_t(dim_t number_of_clocks) : _number_of_clocks(number_of_clocks) {
-        _bounds = std::vector<bound_t>(number_of_clocks * number_of_clocks);
+    bounds_table_t::bounds_table_t(dim_t number_of_clocks, const allocator_type& alloc)
+            : _number_of_clocks(number_of_clocks), _alloc(alloc) {
+        if (is_inline()) {
+            _bounds = _inline_bounds.data();
+        } else {
+            _heap_bounds = std::allocate_shared<bound_t[]>(_alloc, number_of_clocks * number_of_clocks);
+            _bounds = _heap_bounds.get();
+        }
+    }
+
+    bounds_table_t::bounds_table_t(bound_t* bounds, dim_t number_of_clocks)
+            : _number_of_clocks(number_of_clocks), _bounds(bounds), _is_view(true) {}
+
+    bounds_table_t::bounds_table_t(const bounds_table_t& other) : bounds_table_t(other, allocator_type()) {}
+
+    bounds_table_t::bounds_table_t(const bounds_table_t& other, const allocator_type& alloc)
+            : _number_of_clocks(other._number_of_clocks), _is_hashed(other._is_hashed), _hash(other._hash), _alloc(alloc) {
+        if (is_inline()) {
+            std::copy_n(other._bounds, _number_of_clocks * _number_of_clocks, _inline_bounds.data());
+            _bounds = _inline_bounds.data();
+        } else {
+            copy_heap_bounds(other);
+        }
+    }
+
+    bounds_table_t::bounds_table_t(bounds_table_t&& other) noexcept
+            : _number_of_clocks(other._number_of_clocks), _is_hashed(other._is_hashed), _hash(other._hash),
+              _alloc(other._alloc) {
+        if (is_inline()) {
+            std::copy_n(other._bounds, _number_of_clocks * _number_of_clocks, _inline_bounds.data());
+            _bounds = _inline_bounds.data();
+        } else if (other.is_view()) {
+            copy_heap_bounds(other);
+        } else {
+            _heap_bounds = std::move(other._heap_bounds);
+            _bounds = _heap_bounds.get();
+            other._number_of_clocks = 0;
+            other._bounds = other._inline_bounds.data();
+            other._is_hashed = false;
+        }
+    }
+
+    bounds_table_t::bounds_table_t(bounds_table_t&& other, const allocator_type& alloc)
+            : _number_of_clocks(other._number_of_clocks), _alloc(alloc) {
+        *this = std::move(other);
+    }
+
+    bounds_table_t& bounds_table_t::operator=(const bounds_table_t& other) {
+        if (this == &other) return *this;
+
+        _number_of_clocks = other._number_of_clocks;
+        _is_view = false;
+        _is_hashed = other._is_hashed;
+        _hash = other._hash;
+        if (is_inline()) {
+            _heap_bounds.reset();
+            std::copy_n(other._bounds, _number_of_clocks * _number_of_clocks, _inline_bounds.data());
+            _bounds = _inline_bounds.data();
+        } else {
+            copy_heap_bounds(other);
+        }
+        return *this;
+    }
+
+    bounds_table_t& bounds_table_t::operator=(bounds_table_t&& other) noexcept {
+        if (this == &other) return *this;
+
+        if (other.is_inline() || other.is_view() || _alloc != other._alloc)
+            return *this = static_cast<const bounds_table_t&>(other);
+
+        _number_of_clocks = other._number_of_clocks;
+        _is_view = false;
+        _is_hashed = other._is_hashed;
+        _hash = other._hash;
+        _heap_bounds = std::move(other._heap_bounds);
+        _bounds = _heap_bounds.get();
+        other._number_of_clocks = 0;
+        other._bounds = other._inline_bounds.data();
+        other._is_hashed = false;
+        return *this;
+    }
+
+    void bounds_table_t::copy_heap_bounds(const bounds_table_t& other) {
+        if (_alloc == other._alloc && not other.is_view()) {
+            _heap_bounds = other._heap_bounds;
+        } else {
+            _heap_bounds = std::allocate_shared_for_overwrite<bound_t[]>(_alloc, _number_of_clocks * _number_of_clocks);
+            std::copy_n(other._bounds, _number_of_clocks * _number_of_clocks, _heap_bounds.get());
+        }
+        _bounds = _heap_bounds.get();
+    }
+
+    void bounds_table_t::detach() {
+        auto bounds = std::allocate_shared_for_overwrite<bound_t[]>(_alloc, _number_of_clocks * _number_of_clocks);
+        std::copy_n(_bounds, _number_of_clocks * _number_of_clocks, bounds.get());
+        _heap_bounds = std::move(bounds);
+        _bounds = _heap_bounds.get();
     }
 
     dim_t bounds_table_t::number_of_clocks() const {return this->_number_of_clocks;}
 
+    uint64_t bounds_table_t::hash() const {
+        if (_is_hashed)
+            return _hash;
+
+        const uint64_t h = hash_bounds(_bounds, _number_of_clocks * _number_of_clocks);
+        if (not _is_view) {
+            _hash = h;
+            _is_hashed = true;
+        }
+        return h;
+    }
+
+    bounds_table_t::allocator_type bounds_table_t::get_allocator() const {return _alloc;}
+
     std::ostream& operator<<(std::ostream& out, const bounds_table_t& table) {
         out << '\n';
         for (dim_t i = 0; i < table._number_of_clocks; ++i) {
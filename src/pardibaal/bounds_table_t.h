@@ -24,15 +24,50 @@
 #define PARDIBAAL_BOUNDS_TABLE_T_H
 
 #include <vector>
+#include <array>
 #include <ostream>
+#include <memory>
+#include <memory_resource>
 
 #include "bound_t.h"
+#include "hash.h"
 
+// Tables with at most this many clocks (including the zero clock) are stored inline without heap allocation
+#ifndef PARDIBAAL_INLINE_DIMENSION
+#define PARDIBAAL_INLINE_DIMENSION 8
+#endif
 
 namespace pardibaal {
     struct bounds_table_t {
     public:
-        explicit bounds_table_t(dim_t number_of_clocks);
+        static constexpr dim_t INLINE_DIMENSION = PARDIBAAL_INLINE_DIMENSION;
+
+        // Tables that do not fit inline are allocated through this allocator
+        using allocator_type = std::pmr::polymorphic_allocator<bound_t>;
+
+        explicit bounds_table_t(dim_t number_of_clocks, const allocator_type& alloc = {});
+
+        /**
+         * Non-owning table over number_of_clocks^2 row-major bounds owned by the caller.
+         * Copies of the table own their bounds, and assigning to the table makes it owning.
+         * @param bounds caller-provided memory that must outlive the table
+         * @param number_of_clocks number of clocks including the zero clock
+         */
+        bounds_table_t(bound_t* bounds, dim_t number_of_clocks);
+
+        /* Tables that do not fit inline are shared between copies and only copied on the first write (copy-on-write).
+         * As for std::pmr containers, a copy uses the default resource unless an allocator is given,
+         * and the bounds are only shared if both tables use the same resource.
+         * The sharing is not synchronised: whether to copy is decided from the reference count alone, so a table
+         * must not be written while a copy of it is read or written on another thread.
+         * The moves only allocate when the bounds cannot be taken over, and then fail like any allocation
+         * in a noexcept function. */
+        bounds_table_t(const bounds_table_t& other);
+        bounds_table_t(const bounds_table_t& other, const allocator_type& alloc);
+        bounds_table_t(bounds_table_t&& other) noexcept;
+        bounds_table_t(bounds_table_t&& other, const allocator_type& alloc);
+        bounds_table_t& operator=(const bounds_table_t& other);
+        bounds_table_t& operator=(bounds_table_t&& other) noexcept;
 
         /** number of clock including the zero clock
          * same as the dimension of the "matrix"
@@ -40,19 +75,65 @@ namespace pardibaal {
          */
         [[nodiscard]] dim_t number_of_clocks() const;
 
+        [[nodiscard]] allocator_type get_allocator() const;
+
         [[nodiscard]] inline bound_t at(dim_t i, dim_t j) const {
             return _bounds[i * _number_of_clocks + j];
         }
 
         inline void set(dim_t i, dim_t j, bound_t bound) { 
-            this->_bounds[i * _number_of_clocks + j] = bound; 
+            if (is_shared()) detach();
+            const dim_t c = i * _number_of_clocks + j;
+            if (_is_hashed)
+                _hash += hash_term(c, bound) - hash_term(c, this->_bounds[c]);
+            this->_bounds[c] = bound; 
+        }
+
+        /**
+         * Pointer to the first bound of row i. Rows are stored contiguously.
+         * The pointer is invalidated when the table is copied, as the copy may share the bounds.
+         * Writes through the pointer are not tracked, so the cached hash is dropped.
+         */
+        [[nodiscard]] inline bound_t* row(dim_t i) {
+            if (is_shared()) detach();
+            _is_hashed = false;
+            return this->_bounds + i * _number_of_clocks;
         }
+        [[nodiscard]] inline const bound_t* row(dim_t i) const { return this->_bounds + i * _number_of_clocks; }
+
+        /**
+         * hash_bounds of the table. The first call computes it in O(n^2), after which it is kept up to date
+         * in O(1) by set(), until row() gives write access to the bounds. The hash of a view is never kept,
+         * since the caller may write to the bounds directly.
+         */
+        [[nodiscard]] uint64_t hash() const;
+
+        /** @return true if the bounds are stored inline rather than on the heap */
+        [[nodiscard]] inline bool is_inline() const { return _number_of_clocks <= INLINE_DIMENSION; }
+
+        /** @return true if the bounds are caller-provided memory */
+        [[nodiscard]] inline bool is_view() const { return _is_view; }
+
+        /** @return true if the bounds are shared with another table, and will be copied on the next write */
+        [[nodiscard]] inline bool is_shared() const { return not is_inline() && _heap_bounds.use_count() > 1; }
 
         friend std::ostream& operator<<(std::ostream& out, const bounds_table_t& table);
 
     private:
+        // Gives this table its own copy of shared bounds
+        void detach();
+
+        // Shares or copies the heap bounds of other, depending on whether the allocators are equal
+        void copy_heap_bounds(const bounds_table_t& other);
+
         dim_t _number_of_clocks;
-        std::vector<bound_t> _bounds;
+        bound_t* _bounds; // Points into either _inline_bounds, _heap_bounds or caller-provided memory
+        bool _is_view = false;
+        mutable bool _is_hashed = false;
+        mutable uint64_t _hash = 0;
+        allocator_type _alloc;
+        std::shared_ptr<bound_t[]> _heap_bounds;
+        std::array<bound_t, INLINE_DIMENSION * INLINE_DIMENSION> _inline_bounds;
     };
 
     std::ostream& operator<<(std::ostream& out, const bounds_table_t& table);
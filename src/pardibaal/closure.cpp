@@ -0,0 +1,340 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "closure.h"
+#include "bound_t.h"
+#include "fixed_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if !defined(PARDIBAAL_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PARDIBAAL_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace pardibaal {
+
+    namespace {
+        using relax_row_f = void (*)(bound_t*, const bound_t*, bound_t, dim_t);
+
+        void relax_row_scalar(bound_t* row_i, const bound_t* row_k, bound_t b_ik, dim_t dimension) {
+            for (dim_t j = 0; j < dimension; ++j) {
+                bound_t b = b_ik + row_k[j];
+                if (b < row_i[j])
+                    row_i[j] = b;
+            }
+        }
+
+#ifdef PARDIBAAL_X86_SIMD
+        /* Both kernels compute the packed sum b_ik + row_k[j] with the strictness fix-up from bound_t::operator+.
+         * Lanes where row_k[j] is infinity are forced back to infinity before the min, since b_ik is finite. */
+
+        __attribute__((target("avx2")))
+        void relax_row_avx2(bound_t* row_i, const bound_t* row_k, bound_t b_ik, dim_t dimension) {
+            const __m256i inf = _mm256_set1_epi32(bound_t::inf().get_raw());
+            const __m256i one = _mm256_set1_epi32(1);
+            const __m256i b = _mm256_set1_epi32(b_ik.get_raw());
+
+            dim_t j = 0;
+            for (; j + 8 <= dimension; j += 8) {
+                __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row_k + j));
+                __m256i i = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row_i + j));
+                __m256i sum = _mm256_sub_epi32(_mm256_add_epi32(b, k), _mm256_and_si256(_mm256_or_si256(b, k), one));
+                sum = _mm256_blendv_epi8(sum, inf, _mm256_cmpeq_epi32(k, inf));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(row_i + j), _mm256_min_epi32(i, sum));
+            }
+            relax_row_scalar(row_i + j, row_k + j, b_ik, dimension - j);
+        }
+
+        __attribute__((target("sse4.1")))
+        void relax_row_sse41(bound_t* row_i, const bound_t* row_k, bound_t b_ik, dim_t dimension) {
+            const __m128i inf = _mm_set1_epi32(bound_t::inf().get_raw());
+            const __m128i one = _mm_set1_epi32(1);
+            const __m128i b = _mm_set1_epi32(b_ik.get_raw());
+
+            dim_t j = 0;
+            for (; j + 4 <= dimension; j += 4) {
+                __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_k + j));
+                __m128i i = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_i + j));
+                __m128i sum = _mm_sub_epi32(_mm_add_epi32(b, k), _mm_and_si128(_mm_or_si128(b, k), one));
+                sum = _mm_blendv_epi8(sum, inf, _mm_cmpeq_epi32(k, inf));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(row_i + j), _mm_min_epi32(i, sum));
+            }
+            relax_row_scalar(row_i + j, row_k + j, b_ik, dimension - j);
+        }
+#endif
+
+        relax_row_f select_relax_row() {
+#ifdef PARDIBAAL_X86_SIMD
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return relax_row_avx2;
+            if (__builtin_cpu_supports("sse4.1"))
+                return relax_row_sse41;
+#endif
+            return relax_row_scalar;
+        }
+
+        // Selected on first use, so that closing a DBM during static initialisation is safe.
+        relax_row_f relax_row_impl() {
+            static const relax_row_f impl = select_relax_row();
+            return impl;
+        }
+
+        // Whether one of the bounds from i to i, for i in [begin, end), is negative, ie. the matrix is inconsistent
+        inline bool has_negative_diagonal(const bound_t* bounds, dim_t dimension, dim_t begin, dim_t end) {
+            for (dim_t i = begin; i < end; ++i)
+                if (bounds[i * dimension + i] < bound_t::le_zero())
+                    return true;
+            return false;
+        }
+
+        // Floyd-Warshall, which stops after the first pivot that makes a diagonal bound negative
+        bool close_rows(bound_t* bounds, dim_t dimension) {
+            const relax_row_f relax = relax_row_impl();
+            for (dim_t k = 0; k < dimension; ++k) {
+                const bound_t* row_k = bounds + k * dimension;
+                for (dim_t i = 0; i < dimension; ++i) {
+                    bound_t b_ik = bounds[i * dimension + k];
+                    if (b_ik.is_inf()) continue;
+                    relax(bounds + i * dimension, row_k, b_ik, dimension);
+                }
+                if (has_negative_diagonal(bounds, dimension, 0, dimension))
+                    return false;
+            }
+            return true;
+        }
+
+        std::atomic<unsigned> number_of_closure_threads = 1;
+
+        /*
+         * Worker threads for close_bounds_parallel. They are started on first use and kept until the program exits,
+         * so a closure does not start any threads once the pool has grown to the number of closure threads.
+         * A single closure uses the workers at a time, the closure holding busy.
+         */
+        class closure_pool_t {
+        public:
+            std::mutex busy;
+
+            /*
+             * Starts workers until there are n, and returns how many there are.
+             * A thread that fails to start is not retried, so the closure then uses fewer threads.
+             * Must be called while holding busy.
+             */
+            unsigned reserve(unsigned n) {
+                try {
+                    _workers.reserve(n);
+                    while (_workers.size() < n) {
+                        const unsigned t = _workers.size() + 1;
+                        _workers.emplace_back([this, t, generation = _generation](std::stop_token stop) {
+                            work(stop, t, generation);
+                        });
+                    }
+                } catch (const std::exception&) {}
+                return std::min<unsigned>(n, _workers.size());
+            }
+
+            /*
+             * Runs job(t) on worker t for t in [1, participants), and job(0) on the calling thread,
+             * and returns when all have returned.
+             * Must be called while holding busy, with at least participants - 1 workers.
+             */
+            template<typename F>
+            void run(F& job, unsigned participants) {
+                {
+                    std::lock_guard lock(_mutex);
+                    _job = &job;
+                    _call = [](void* f, unsigned t) {(*static_cast<F*>(f))(t);};
+                    _participants = participants;
+                    _running = participants - 1;
+                    ++_generation;
+                }
+                _start.notify_all();
+                job(0);
+
+                std::unique_lock lock(_mutex);
+                _done.wait(lock, [this] {return _running == 0;});
+            }
+
+        private:
+            void work(std::stop_token stop, unsigned t, uint64_t generation) {
+                std::unique_lock lock(_mutex);
+                while (_start.wait(lock, stop, [this, generation] {return _generation != generation;})) {
+                    generation = _generation;
+                    if (t >= _participants) continue;
+
+                    void* job = _job;
+                    void (*call)(void*, unsigned) = _call;
+                    lock.unlock();
+                    call(job, t);
+                    lock.lock();
+                    if (--_running == 0)
+                        _done.notify_one();
+                }
+            }
+
+            std::mutex _mutex;
+            std::condition_variable_any _start;
+            std::condition_variable _done;
+            void* _job = nullptr;
+            void (*_call)(void*, unsigned) = nullptr;
+            unsigned _participants = 0, _running = 0;
+            uint64_t _generation = 0;
+
+            // Last, such that the workers are stopped and joined before the state they use is destroyed
+            std::vector<std::jthread> _workers;
+        };
+
+        closure_pool_t& closure_pool() {
+            static closure_pool_t pool;
+            return pool;
+        }
+    }
+
+    void set_closure_threads(unsigned threads) {
+        number_of_closure_threads = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    unsigned closure_threads() {
+        return number_of_closure_threads;
+    }
+
+    void relax_row(bound_t* row_i, const bound_t* row_k, bound_t b_ik, dim_t dimension) {
+        relax_row_impl()(row_i, row_k, b_ik, dimension);
+    }
+
+    bool close_bounds(bound_t* bounds, dim_t dimension) {
+        if (has_negative_diagonal(bounds, dimension, 0, dimension))
+            return false;
+
+        bool is_consistent = true;
+        auto close_fixed = [bounds, &is_consistent]<dim_t N>(std::integral_constant<dim_t, N>) {
+            is_consistent = fixed::close<N>(bounds);
+        };
+        if (fixed::dispatch_fixed<fixed::MAX_CLOSE_DIMENSION>(dimension, close_fixed))
+            return is_consistent;
+
+        if (dimension >= PARALLEL_CLOSURE_DIMENSION) {
+            const unsigned threads = closure_threads();
+            if (threads > 1)
+                return close_bounds_parallel(bounds, dimension, threads);
+        }
+
+        return close_rows(bounds, dimension);
+    }
+
+    bool close_bounds_parallel(bound_t* bounds, dim_t dimension, unsigned threads) {
+        if (has_negative_diagonal(bounds, dimension, 0, dimension))
+            return false;
+
+        const relax_row_f relax = relax_row_impl();
+        threads = std::max(1u, std::min<unsigned>(threads, dimension));
+        if (threads == 1)
+            return close_rows(bounds, dimension);
+
+        // Another closure using the workers is not waited for, this one then runs on the calling thread
+        closure_pool_t& pool = closure_pool();
+        std::unique_lock busy(pool.busy, std::try_to_lock);
+        threads = busy.owns_lock() ? pool.reserve(threads - 1) + 1 : 1;
+        if (threads == 1)
+            return close_rows(bounds, dimension);
+
+        // At pivot k, every row but row k is relaxed through row k. Row k would only change if the bound from k to k
+        // were negative, and then the closure has already stopped, so the rows can be relaxed in any order.
+        // Like the sequential closure, the threads stop after the first pivot that makes a diagonal bound negative.
+        // The completion step runs on a single thread between pivots, so it can update the shared state.
+        dim_t k = 0;
+        bool is_consistent = true;
+        std::atomic<bool> found_negative = false;
+        auto next_pivot = [&]() noexcept {
+            if (found_negative.load(std::memory_order_relaxed)) {
+                is_consistent = false;
+                k = dimension;
+            } else {
+                ++k;
+            }
+        };
+        std::barrier sync(threads, next_pivot);
+
+        // Thread t relaxes the rows [t * dimension / threads, (t + 1) * dimension / threads)
+        auto work = [&](unsigned t) {
+            const dim_t i_begin = t * dimension / threads, i_end = (t + 1) * dimension / threads;
+            while (k < dimension) {
+                const bound_t* row_k = bounds + k * dimension;
+                for (dim_t i = i_begin; i < i_end; ++i) {
+                    bound_t b_ik = bounds[i * dimension + k];
+                    if (i == k || b_ik.is_inf()) continue;
+                    relax(bounds + i * dimension, row_k, b_ik, dimension);
+                }
+                if (has_negative_diagonal(bounds, dimension, i_begin, i_end))
+                    found_negative.store(true, std::memory_order_relaxed);
+                sync.arrive_and_wait();
+            }
+        };
+        pool.run(work, threads);
+
+        return is_consistent;
+    }
+
+    bool close_bounds_clock(bound_t* bounds, dim_t dimension, dim_t k) {
+        const relax_row_f relax = relax_row_impl();
+        bound_t* row_k = bounds + k * dimension;
+
+        // Shortest paths into k, where the prefix only passes through the closed part
+        for (dim_t i = 0; i < dimension; ++i) {
+            const bound_t* row_i = bounds + i * dimension;
+            bound_t b_ik = row_i[k];
+            for (dim_t j = 0; j < dimension; ++j) {
+                bound_t b = row_i[j] + bounds[j * dimension + k];
+                if (b < b_ik)
+                    b_ik = b;
+            }
+            bounds[i * dimension + k] = b_ik;
+        }
+
+        // A negative cycle through k
+        if (row_k[k] < bound_t::le_zero())
+            return false;
+
+        // Shortest paths out of k
+        for (dim_t j = 0; j < dimension; ++j) {
+            bound_t b_kj = row_k[j];
+            if (b_kj.is_inf()) continue;
+            relax(row_k, bounds + j * dimension, b_kj, dimension);
+        }
+
+        // All paths through k
+        for (dim_t i = 0; i < dimension; ++i) {
+            bound_t b_ik = bounds[i * dimension + k];
+            if (b_ik.is_inf()) continue;
+            relax(bounds + i * dimension, row_k, b_ik, dimension);
+        }
+
+        return not has_negative_diagonal(bounds, dimension, 0, dimension);
+    }
+}
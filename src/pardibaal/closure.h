@@ -0,0 +1,91 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARDIBAAL_CLOSURE_H
+#define PARDIBAAL_CLOSURE_H
+
+#include "bound_t.h"
+
+namespace pardibaal {
+
+    /** Smallest dimension (including the zero clock) closed with close_bounds_parallel when enabled */
+    constexpr dim_t PARALLEL_CLOSURE_DIMENSION = 128;
+
+    /**
+     * Sets the number of threads used to close DBMs of PARALLEL_CLOSURE_DIMENSION and up.
+     * The default is 1, ie. no threads are started. 0 uses std::thread::hardware_concurrency().
+     * Applies to all closures started afterwards, from any thread.
+     * The threads are started by the first closure that uses them, and are kept until the program exits.
+     */
+    void set_closure_threads(unsigned threads);
+
+    /** The number of threads set with set_closure_threads */
+    [[nodiscard]] unsigned closure_threads();
+
+    /**
+     * Tightens a row through a pivot row:
+     * row_i[j] = min(row_i[j], b_ik + row_k[j]) for all j < dimension.
+     * Uses AVX2 or SSE4.1 when the CPU supports it, otherwise a scalar loop.
+     * row_i and row_k may be the same row.
+     * @param row_i row being tightened
+     * @param row_k pivot row
+     * @param b_ik the bound from i to k, must not be infinity
+     * @param dimension number of bounds in a row
+     */
+    void relax_row(bound_t* row_i, const bound_t* row_k, bound_t b_ik, dim_t dimension);
+
+    /**
+     * Floyd-Warshall closure of a row-major dimension x dimension matrix of bounds.
+     * Uses close_bounds_parallel from PARALLEL_CLOSURE_DIMENSION and up if more than one closure thread is set.
+     * Stops after the first pivot that makes a bound from a clock to itself negative.
+     * @param bounds pointer to the first bound of the matrix
+     * @param dimension number of clocks including the zero clock
+     * @return false if the matrix is inconsistent (the zone is empty), in which case it is only partially closed
+     */
+    bool close_bounds(bound_t* bounds, dim_t dimension);
+
+    /**
+     * Floyd-Warshall closure where the rows are split between threads, which synchronise after each pivot.
+     * The result is identical to that of close_bounds, also when the matrix is inconsistent (empty).
+     * The closure threads are shared, so while another closure uses them this one runs on the calling thread.
+     * It also uses fewer threads if some cannot be started.
+     * @param bounds pointer to the first bound of the matrix
+     * @param dimension number of clocks including the zero clock
+     * @param threads maximal number of threads including the calling thread
+     * @return false if the matrix is inconsistent, see close_bounds
+     */
+    bool close_bounds_parallel(bound_t* bounds, dim_t dimension, unsigned threads);
+
+    /**
+     * Incremental closure for a single clock in O(n^2).
+     * Assumes that the matrix restricted to the clocks that have not yet been re-closed is closed,
+     * ie. only the row and column of k (and of other clocks that are re-closed afterwards) have changed.
+     * Calling this for every changed clock gives the same result as close_bounds.
+     * @param bounds pointer to the first bound of the matrix
+     * @param dimension number of clocks including the zero clock
+     * @param k the clock whose row and column have changed
+     * @return false if the matrix is inconsistent, in which case the remaining clocks need not be closed
+     */
+    bool close_bounds_clock(bound_t* bounds, dim_t dimension, dim_t k);
+}
+
+#endif //PARDIBAAL_CLOSURE_H
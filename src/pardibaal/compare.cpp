@@ -0,0 +1,124 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "compare.h"
+#include "bound_t.h"
+
+#if !defined(PARDIBAAL_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PARDIBAAL_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace pardibaal {
+
+    namespace {
+        /*
+         * The kernels compare the raw bounds, which are ordered as the bounds, and collect per row whether some
+         * bound of lhs is above (not subset) or below (not superset) the bound of rhs.
+         */
+        using compare_f = void (*)(const bound_t*, const bound_t*, dim_t, bool&, bool&);
+
+        inline void compare_row_scalar(const bound_t* lhs, const bound_t* rhs, dim_t size, bool& above, bool& below) {
+            for (dim_t j = 0; j < size; ++j) {
+                above |= lhs[j] > rhs[j];
+                below |= lhs[j] < rhs[j];
+            }
+        }
+
+        void compare_scalar(const bound_t* lhs, const bound_t* rhs, dim_t dimension, bool& subset, bool& superset) {
+            for (dim_t i = 0; i < dimension; ++i) {
+                bool above = false, below = false;
+                compare_row_scalar(lhs + i * dimension, rhs + i * dimension, dimension, above, below);
+                subset = subset && !above;
+                superset = superset && !below;
+                if (!subset && !superset) return;
+            }
+        }
+
+#ifdef PARDIBAAL_X86_SIMD
+        __attribute__((target("avx2")))
+        void compare_avx2(const bound_t* lhs, const bound_t* rhs, dim_t dimension, bool& subset, bool& superset) {
+            for (dim_t i = 0; i < dimension; ++i) {
+                const bound_t* l = lhs + i * dimension;
+                const bound_t* r = rhs + i * dimension;
+                __m256i above = _mm256_setzero_si256(), below = _mm256_setzero_si256();
+
+                dim_t j = 0;
+                for (; j + 8 <= dimension; j += 8) {
+                    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + j));
+                    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + j));
+                    above = _mm256_or_si256(above, _mm256_cmpgt_epi32(a, b));
+                    below = _mm256_or_si256(below, _mm256_cmpgt_epi32(b, a));
+                }
+
+                bool row_above = !_mm256_testz_si256(above, above), row_below = !_mm256_testz_si256(below, below);
+                compare_row_scalar(l + j, r + j, dimension - j, row_above, row_below);
+                subset = subset && !row_above;
+                superset = superset && !row_below;
+                if (!subset && !superset) return;
+            }
+        }
+
+        __attribute__((target("sse4.1")))
+        void compare_sse41(const bound_t* lhs, const bound_t* rhs, dim_t dimension, bool& subset, bool& superset) {
+            for (dim_t i = 0; i < dimension; ++i) {
+                const bound_t* l = lhs + i * dimension;
+                const bound_t* r = rhs + i * dimension;
+                __m128i above = _mm_setzero_si128(), below = _mm_setzero_si128();
+
+                dim_t j = 0;
+                for (; j + 4 <= dimension; j += 4) {
+                    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l + j));
+                    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + j));
+                    above = _mm_or_si128(above, _mm_cmpgt_epi32(a, b));
+                    below = _mm_or_si128(below, _mm_cmpgt_epi32(b, a));
+                }
+
+                bool row_above = !_mm_testz_si128(above, above), row_below = !_mm_testz_si128(below, below);
+                compare_row_scalar(l + j, r + j, dimension - j, row_above, row_below);
+                subset = subset && !row_above;
+                superset = superset && !row_below;
+                if (!subset && !superset) return;
+            }
+        }
+#endif
+
+        compare_f select_compare() {
+#ifdef PARDIBAAL_X86_SIMD
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return compare_avx2;
+            if (__builtin_cpu_supports("sse4.1"))
+                return compare_sse41;
+#endif
+            return compare_scalar;
+        }
+    }
+
+    void compare_bounds(const bound_t* lhs, const bound_t* rhs, dim_t dimension, bool& subset, bool& superset) {
+        // Selected on first use, so that comparing DBMs during static initialisation is safe.
+        static const compare_f compare = select_compare();
+        subset = true;
+        superset = true;
+        compare(lhs, rhs, dimension, subset, superset);
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARDIBAAL_COMPARE_H
+#define PARDIBAAL_COMPARE_H
+
+#include "bound_t.h"
+
+namespace pardibaal {
+
+    /**
+     * Element-wise comparison of two row-major dimension x dimension matrices of bounds.
+     * A row at a time is compared with AVX2 or SSE4.1 when the CPU supports it, otherwise with a scalar loop,
+     * and the comparison stops after the first row where both subset and superset are known to be false.
+     * @param lhs pointer to the first bound of the left matrix
+     * @param rhs pointer to the first bound of the right matrix
+     * @param dimension number of clocks including the zero clock
+     * @param subset set to whether all bounds of lhs are below or equal to those of rhs
+     * @param superset set to whether all bounds of lhs are above or equal to those of rhs
+     */
+    void compare_bounds(const bound_t* lhs, const bound_t* rhs, dim_t dimension, bool& subset, bool& superset);
+}
+
+#endif //PARDIBAAL_COMPARE_H
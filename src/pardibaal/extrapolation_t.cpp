@@ -0,0 +1,128 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "extrapolation_t.h"
+#include "errors.h"
+
+namespace pardibaal {
+
+    /*
+     * For a bound b with value v:
+     *   v > c   iff  b > (c, <=)
+     *   -v > c  iff  b < (-c, <)
+     * so the constants are turned into bounds once, and each bound is compared without unpacking it.
+     */
+    extrapolation_t::extrapolation_t(kind_e kind, const std::vector<val_t>& lower, const std::vector<val_t>& upper)
+        : _kind(kind) {
+#ifndef NEXCEPTIONS
+        if (lower.size() != upper.size())
+            throw base_error("ERROR: Got LU constants vector of size ", lower.size(), " and ", upper.size(),
+                             " but they must be equal");
+#endif
+        const dim_t dimension = lower.size();
+        _row_max.reserve(dimension);
+        _col_min.reserve(dimension);
+        for (dim_t i = 0; i < dimension; ++i) {
+            _row_max.push_back(bound_t::non_strict(lower[i]));
+            _col_min.push_back(bound_t::strict(-upper[i]));
+        }
+
+        if (kind == M_DIAGONAL || kind == LU_DIAGONAL) {
+            _row_cut.reserve(dimension);
+            for (dim_t i = 0; i < dimension; ++i)
+                _row_cut.push_back(bound_t::strict(-lower[i]));
+        }
+    }
+
+    extrapolation_t extrapolation_t::m(const std::vector<val_t>& ceiling) {
+        return extrapolation_t(M, ceiling, ceiling);
+    }
+
+    extrapolation_t extrapolation_t::m_diagonal(const std::vector<val_t>& ceiling) {
+        return extrapolation_t(M_DIAGONAL, ceiling, ceiling);
+    }
+
+    extrapolation_t extrapolation_t::lu(const std::vector<val_t>& lower, const std::vector<val_t>& upper) {
+        return extrapolation_t(LU, lower, upper);
+    }
+
+    extrapolation_t extrapolation_t::lu_diagonal(const std::vector<val_t>& lower, const std::vector<val_t>& upper) {
+        return extrapolation_t(LU_DIAGONAL, lower, upper);
+    }
+
+    // The DBM::extrapolate* functions compare get_bound() of inf, which is 0, so inf is compared as <=0
+    static inline bound_t compared(bound_t b) {
+        return b.is_inf() ? bound_t::le_zero() : b;
+    }
+
+    template<extrapolation_t::kind_e kind>
+    bool extrapolation_t::extrapolate_row(bound_t* row, const bound_t* row_0, dim_t i) const {
+        constexpr bool is_diagonal = kind == M_DIAGONAL || kind == LU_DIAGONAL;
+        const dim_t dimension = this->dimension();
+        const bound_t row_max = _row_max[i];
+        const bool is_row_inf = is_diagonal && compared(row_0[i]) < _row_cut[i];
+        bool changed = false;
+
+        for (dim_t j = 0; j < dimension; ++j) {
+            const bound_t old = row[j];
+            bound_t b = old;
+
+            if constexpr (kind == M) {
+                if (not b.is_inf() && b > row_max)
+                    b = bound_t::inf();
+                else if (b < _col_min[j])
+                    b = _col_min[j];
+            } else {
+                if (i == j) continue;
+                const bound_t v = compared(old);
+
+                if (v > row_max || is_row_inf || (is_diagonal && i != 0 && compared(row_0[j]) < _col_min[j]))
+                    b = bound_t::inf();
+                else if (v < _col_min[j] && (kind == LU || i == 0))
+                    b = _col_min[j];
+
+                // Make sure we don't set 0, j to positive bound or i, 0 to a negative one
+                if (i == 0 && b > bound_t::le_zero())
+                    b = bound_t::le_zero();
+                if (j == 0 && b < bound_t::le_zero())
+                    b = bound_t::le_zero();
+            }
+
+            if (b != old) {
+                row[j] = b;
+                changed = true;
+            }
+        }
+
+        return changed;
+    }
+
+    bool extrapolation_t::extrapolate_row(bound_t* row, const bound_t* row_0, dim_t i) const {
+        switch (_kind) {
+            case M:           return extrapolate_row<M>(row, row_0, i);
+            case M_DIAGONAL:  return extrapolate_row<M_DIAGONAL>(row, row_0, i);
+            case LU:          return extrapolate_row<LU>(row, row_0, i);
+            case LU_DIAGONAL: return extrapolate_row<LU_DIAGONAL>(row, row_0, i);
+        }
+        return false;
+    }
+}
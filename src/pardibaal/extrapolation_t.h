@@ -0,0 +1,87 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARDIBAAL_EXTRAPOLATION_T_H
+#define PARDIBAAL_EXTRAPOLATION_T_H
+
+#include <vector>
+
+#include "bound_t.h"
+
+namespace pardibaal {
+
+    /**
+     * Extrapolation constants (M or LU bounds) of a location, compiled once and applied to many zones
+     * with DBM::extrapolate(const extrapolation_t&) or Federation::extrapolate(const extrapolation_t&).
+     * The result is the same as with the corresponding DBM::extrapolate* function, but the constants
+     * are only validated once, and the bounds they are compared with are precomputed per clock.
+     */
+    class extrapolation_t {
+    public:
+        enum kind_e {M, M_DIAGONAL, LU, LU_DIAGONAL};
+
+    private:
+        kind_e _kind;
+
+        // Bounds in row i above _row_max[i] become inf, and bounds in column j below _col_min[j] become _col_min[j]
+        std::vector<bound_t> _row_max, _col_min;
+
+        // Diagonal extrapolation: rows of clocks whose lower bound is below _row_cut become inf,
+        // and so do columns (except in row 0) of clocks whose lower bound is below _col_min
+        std::vector<bound_t> _row_cut;
+
+        extrapolation_t(kind_e kind, const std::vector<val_t>& lower, const std::vector<val_t>& upper);
+
+        template<kind_e kind>
+        bool extrapolate_row(bound_t* row, const bound_t* row_0, dim_t i) const;
+
+    public:
+        /** Same as DBM::extrapolate */
+        static extrapolation_t m(const std::vector<val_t>& ceiling);
+
+        /** Same as DBM::extrapolate_diagonal */
+        static extrapolation_t m_diagonal(const std::vector<val_t>& ceiling);
+
+        /** Same as DBM::extrapolate_lu */
+        static extrapolation_t lu(const std::vector<val_t>& lower, const std::vector<val_t>& upper);
+
+        /** Same as DBM::extrapolate_lu_diagonal */
+        static extrapolation_t lu_diagonal(const std::vector<val_t>& lower, const std::vector<val_t>& upper);
+
+        [[nodiscard]] inline kind_e kind() const {return _kind;}
+
+        /** Number of clocks including the zero clock */
+        [[nodiscard]] inline dim_t dimension() const {return _row_max.size();}
+
+        /**
+         * Extrapolates row i of a closed DBM in place.
+         * The diagonal extrapolations read the lower bounds in row 0, so row 0 must be extrapolated last.
+         * @param row the bounds of row i
+         * @param row_0 the bounds of row 0
+         * @param i index of the row
+         * @return true if any bound changed
+         */
+        bool extrapolate_row(bound_t* row, const bound_t* row_0, dim_t i) const;
+    };
+}
+
+#endif //PARDIBAAL_EXTRAPOLATION_T_H
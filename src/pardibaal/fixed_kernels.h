@@ -0,0 +1,151 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARDIBAAL_FIXED_KERNELS_H
+#define PARDIBAAL_FIXED_KERNELS_H
+
+#include <utility>
+#include <type_traits>
+
+#include "bound_t.h"
+
+/*
+ * Kernels for DBMs with a dimension known at compile time.
+ * The loops over rows and columns are unrolled, which removes the loop overhead that dominates for small DBMs.
+ * The dispatch_fixed function selects the kernel from a runtime dimension.
+ */
+namespace pardibaal::fixed {
+
+    /** Largest dimension (including the zero clock) with a fixed dimension kernel */
+    constexpr dim_t MAX_DIMENSION = 8;
+
+    /**
+     * Largest dimension closed with the fixed kernel, see BM_DBM_close_small.
+     * From 8 clocks a row fills an AVX2 register, and the generic row kernel is about twice as fast.
+     */
+    constexpr dim_t MAX_CLOSE_DIMENSION = 7;
+
+    /**
+     * Calls f(std::integral_constant<dim_t, dimension>{}) if there is a fixed kernel for the dimension.
+     * @return true if f was called
+     */
+    template<typename F, dim_t... Ns>
+    inline bool dispatch_fixed(dim_t dimension, F&& f, std::integer_sequence<dim_t, Ns...>) {
+        return ((dimension == Ns + 1 && (f(std::integral_constant<dim_t, Ns + 1>{}), true)) || ...);
+    }
+
+    /** As above, for the dimensions up to max */
+    template<dim_t max = MAX_DIMENSION, typename F>
+    inline bool dispatch_fixed(dim_t dimension, F&& f) {
+        static_assert(max <= MAX_DIMENSION);
+        return dispatch_fixed(dimension, std::forward<F>(f), std::make_integer_sequence<dim_t, max>{});
+    }
+
+    template<dim_t N, dim_t... Js>
+    inline void relax_row(bound_t* row_i, const bound_t* row_k, bound_t b_ik, std::integer_sequence<dim_t, Js...>) {
+        if (b_ik.is_inf()) return;
+        ((row_i[Js] = bound_t::min(row_i[Js], b_ik + row_k[Js])), ...);
+    }
+
+    template<dim_t N, dim_t... Is>
+    inline void relax_all(bound_t* bounds, dim_t k, std::integer_sequence<dim_t, Is...>) {
+        (relax_row<N>(bounds + Is * N, bounds + k * N, bounds[Is * N + k], std::make_integer_sequence<dim_t, N>{}), ...);
+    }
+
+    template<dim_t N, dim_t... Is>
+    inline bool has_negative_diagonal(const bound_t* bounds, std::integer_sequence<dim_t, Is...>) {
+        return ((bounds[Is * N + Is] < bound_t::le_zero()) || ...);
+    }
+
+    /**
+     * Floyd-Warshall closure of an N x N row-major matrix, which skips rows with an infinite bound to the pivot.
+     * Stops after the first pivot that makes a diagonal bound negative.
+     * @return false if the matrix is inconsistent
+     */
+    template<dim_t N>
+    inline bool close(bound_t* bounds) {
+        for (dim_t k = 0; k < N; ++k) {
+            relax_all<N>(bounds, k, std::make_integer_sequence<dim_t, N>{});
+            if (has_negative_diagonal<N>(bounds, std::make_integer_sequence<dim_t, N>{}))
+                return false;
+        }
+        return true;
+    }
+
+    template<dim_t... Cs>
+    inline void compare(const bound_t* lhs, const bound_t* rhs, bool& subset, bool& superset,
+                        std::integer_sequence<dim_t, Cs...>) {
+        subset = subset && ((lhs[Cs] <= rhs[Cs]) && ...);
+        superset = superset && ((lhs[Cs] >= rhs[Cs]) && ...);
+    }
+
+    /**
+     * Element-wise comparison of two N x N matrices.
+     * @param subset set to whether all bounds of lhs are below those of rhs
+     * @param superset set to whether all bounds of lhs are above those of rhs
+     */
+    template<dim_t N>
+    inline void relation(const bound_t* lhs, const bound_t* rhs, bool& subset, bool& superset) {
+        subset = true;
+        superset = true;
+        compare(lhs, rhs, subset, superset, std::make_integer_sequence<dim_t, N * N>{});
+    }
+
+    template<dim_t N, dim_t C>
+    inline bool extrapolate_lu_cell(bound_t* bounds, const val_t* lower, const val_t* upper) {
+        constexpr dim_t i = C / N, j = C % N;
+        if constexpr (i == j) return false;
+
+        const bound_t old = bounds[C];
+        bound_t b = old;
+        if (b.get_bound() > lower[i])
+            b = bound_t::inf();
+        else if (-b.get_bound() > upper[j])
+            b = bound_t::strict(-upper[j]);
+
+        if (i == 0 && b > bound_t::le_zero())
+            b = bound_t::le_zero();
+        if (j == 0 && b < bound_t::le_zero())
+            b = bound_t::le_zero();
+
+        bounds[C] = b;
+        return b != old;
+    }
+
+    template<dim_t N, dim_t... Cs>
+    inline bool extrapolate_lu(bound_t* bounds, const val_t* lower, const val_t* upper,
+                               std::integer_sequence<dim_t, Cs...>) {
+        return (extrapolate_lu_cell<N, Cs>(bounds, lower, upper) | ...);
+    }
+
+    /**
+     * In-place LU extrapolation of an N x N matrix, see DBM::extrapolate_lu.
+     * The matrix is not closed afterwards.
+     * @return true if any bound changed
+     */
+    template<dim_t N>
+    inline bool extrapolate_lu(bound_t* bounds, const val_t* lower, const val_t* upper) {
+        return extrapolate_lu<N>(bounds, lower, upper, std::make_integer_sequence<dim_t, N * N>{});
+    }
+}
+
+#endif //PARDIBAAL_FIXED_KERNELS_H
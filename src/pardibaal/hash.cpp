@@ -0,0 +1,92 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "hash.h"
+
+#if !defined(PARDIBAAL_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PARDIBAAL_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace pardibaal {
+
+    namespace {
+        using hash_f = uint64_t (*)(const bound_t*, uint32_t);
+
+        uint64_t hash_scalar(const bound_t* bounds, uint32_t size) {
+            uint64_t h = 0;
+            for (uint32_t c = 0; c < size; ++c)
+                h += hash_term(c, bounds[c]);
+            return h;
+        }
+
+#ifdef PARDIBAAL_X86_SIMD
+        // hash_term for eight positions at a time, the 64-bit terms are formed by interleaving the lo and hi lanes
+        __attribute__((target("avx2")))
+        uint64_t hash_avx2(const bound_t* bounds, uint32_t size) {
+            const __m256i golden = _mm256_set1_epi32((int32_t) 0x9E3779B9u);
+            const __m256i m1 = _mm256_set1_epi32((int32_t) 0x85EBCA6Bu);
+            const __m256i m_lo = _mm256_set1_epi32((int32_t) 0xC2B2AE35u);
+            const __m256i m_hi = _mm256_set1_epi32((int32_t) 0x27D4EB2Fu);
+            const __m256i step = _mm256_set1_epi32(8);
+            __m256i c = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            __m256i sum = _mm256_setzero_si256();
+
+            uint32_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bounds + i));
+                x = _mm256_xor_si256(x, _mm256_mullo_epi32(c, golden));
+                x = _mm256_mullo_epi32(x, m1);
+                x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+                __m256i lo = _mm256_mullo_epi32(x, m_lo), hi = _mm256_mullo_epi32(x, m_hi);
+                lo = _mm256_xor_si256(lo, _mm256_srli_epi32(lo, 13));
+                hi = _mm256_xor_si256(hi, _mm256_srli_epi32(hi, 15));
+                sum = _mm256_add_epi64(sum, _mm256_unpacklo_epi32(lo, hi));
+                sum = _mm256_add_epi64(sum, _mm256_unpackhi_epi32(lo, hi));
+                c = _mm256_add_epi32(c, step);
+            }
+
+            alignas(32) uint64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+            uint64_t h = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+            for (; i < size; ++i)
+                h += hash_term(i, bounds[i]);
+            return h;
+        }
+#endif
+
+        hash_f select_hash() {
+#ifdef PARDIBAAL_X86_SIMD
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return hash_avx2;
+#endif
+            return hash_scalar;
+        }
+    }
+
+    uint64_t hash_bounds(const bound_t* bounds, uint32_t size) {
+        // Selected on first use, so that hashing DBMs during static initialisation is safe.
+        static const hash_f hash = select_hash();
+        return hash(bounds, size);
+    }
+}
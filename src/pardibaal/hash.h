@@ -0,0 +1,66 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARDIBAAL_HASH_H
+#define PARDIBAAL_HASH_H
+
+#include <cstdint>
+
+#include "bound_t.h"
+
+namespace pardibaal {
+
+    /*
+     * The hash of a table of bounds is the sum of a mixed term for each (position, bound) pair.
+     * Being a sum, the hash is updated in O(1) when a single bound changes: add the new term and subtract the old.
+     * Each term is two 32-bit mixes of the position and the raw bound, so the sum vectorises with 32-bit lanes.
+     */
+
+    /** The term of a bound at position c (i * dimension + j) in the sum computed by hash_bounds */
+    [[nodiscard]] inline uint64_t hash_term(uint32_t c, bound_t bound) {
+        uint32_t x = (uint32_t) bound.get_raw() ^ (c * 0x9E3779B9u);
+        x *= 0x85EBCA6Bu;
+        x ^= x >> 16;
+        uint32_t lo = x * 0xC2B2AE35u, hi = x * 0x27D4EB2Fu;
+        lo ^= lo >> 13;
+        hi ^= hi >> 15;
+        return (uint64_t) hi << 32 | lo;
+    }
+
+    /**
+     * Sum of hash_term(c, bounds[c]) for all c < size (modulo 2^64).
+     * Uses AVX2 when the CPU supports it, otherwise a scalar loop.
+     */
+    [[nodiscard]] uint64_t hash_bounds(const bound_t* bounds, uint32_t size);
+
+    /** Spreads the bits of a sum of terms, such that eg. hash tables can use the low bits */
+    [[nodiscard]] inline uint64_t hash_finalize(uint64_t h) {
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 27;
+        h *= 0x94D049BB133111EBull;
+        h ^= h >> 31;
+        return h;
+    }
+}
+
+#endif //PARDIBAAL_HASH_H
@@ -0,0 +1,117 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE PARDIBAAL
+
+#include <boost/test/unit_test.hpp>
+#include "pardibaal/DBMView.h"
+#include "pardibaal/Federation.h"
+
+using namespace pardibaal;
+
+BOOST_AUTO_TEST_CASE(view_in_place_test_1) {
+    for (dim_t dim : {dim_t(4), dim_t(12)}) {
+        // A zero zone written by the caller
+        std::vector<bound_t> buffer(dim * dim, bound_t::le_zero());
+        DBMView view(buffer.data(), dim);
+        DBM D(dim);
+
+        view.future();
+        view.restrict(difference_bound_t::upper_non_strict(1, 5));
+        view.free(2);
+        view.restrict(difference_bound_t::lower_strict(2, 3));
+        D.future();
+        D.restrict(difference_bound_t::upper_non_strict(1, 5));
+        D.free(2);
+        D.restrict(difference_bound_t::lower_strict(2, 3));
+
+        BOOST_CHECK(view.relation(D).is_equal());
+        BOOST_CHECK(not view.is_empty());
+        for (dim_t i = 0; i < dim; ++i)
+            for (dim_t j = 0; j < dim; ++j)
+                BOOST_CHECK(buffer[i * dim + j] == D.at(i, j));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(view_copy_test_1) {
+    const dim_t dim = 12;
+    std::vector<bound_t> buffer(dim * dim, bound_t::le_zero());
+    DBMView view(buffer.data(), dim);
+    view.future();
+
+    // Copies of the view own their bounds
+    DBM D = view.dbm();
+    Federation fed(view.dbm());
+    view.restrict(difference_bound_t::upper_strict(3, 2));
+
+    BOOST_CHECK(D.at(3, 0) == bound_t::inf());
+    BOOST_CHECK(fed.at(0).at(3, 0) == bound_t::inf());
+    BOOST_CHECK(buffer[3 * dim] == bound_t::strict(2));
+    BOOST_CHECK(view.relation(D).is_subset());
+}
+
+BOOST_AUTO_TEST_CASE(view_reopen_test_1) {
+    const dim_t dim = 4;
+    std::vector<bound_t> buffer(dim * dim, bound_t::le_zero());
+    {
+        DBMView view(buffer.data(), dim);
+        view.future();
+        view.set(1, 0, bound_t::non_strict(5));
+    }
+
+    // The bounds were closed when the first view was destroyed
+    DBM D(dim);
+    D.future();
+    D.restrict(1, 0, bound_t::non_strict(5));
+    {
+        DBMView view(buffer.data(), dim);
+        BOOST_CHECK(view.relation(D).is_equal());
+        for (dim_t i = 0; i < dim; ++i)
+            for (dim_t j = 0; j < dim; ++j)
+                BOOST_CHECK(buffer[i * dim + j] == D.at(i, j));
+
+        // Found empty without writing the bound
+        view.restrict(1, 0, bound_t::strict(0));
+        BOOST_CHECK(view.is_empty());
+    }
+
+    DBMView view(buffer.data(), dim);
+    BOOST_CHECK(view.is_empty());
+    BOOST_CHECK(buffer[0] == bound_t::lt_zero());
+}
+
+BOOST_AUTO_TEST_CASE(view_extrapolate_test_1) {
+    const dim_t dim = 3;
+    std::vector<bound_t> buffer(dim * dim, bound_t::le_zero());
+    DBMView view(buffer.data(), dim, false);
+    view.set(0, 1, bound_t::non_strict(-2));
+    view.set(0, 2, bound_t::non_strict(-2));
+    view.set(1, 0, bound_t::non_strict(5));
+    view.set(2, 0, bound_t::non_strict(7));
+    view.set(2, 1, bound_t::non_strict(2));
+
+    view.extrapolate_lu({0, 1, 1}, {0, 1, 7});
+
+    BOOST_CHECK(buffer[0 * dim + 1] == bound_t::strict(-1));
+    BOOST_CHECK(buffer[1 * dim + 0] == bound_t::inf());
+    BOOST_CHECK(buffer[2 * dim + 1] == bound_t::inf());
+}
@@ -24,8 +24,13 @@
 
 #include <boost/test/unit_test.hpp>
 #include "pardibaal/DBM.h"
+#include "pardibaal/closure.h"
+#include "pardibaal/compare.h"
 #include "errors.h"
 
+#include <numeric>
+#include <thread>
+
 using namespace pardibaal;
 
 BOOST_AUTO_TEST_CASE(close_test_1) {
@@ -46,6 +51,227 @@ BOOST_AUTO_TEST_CASE(close_test_1) {
             BOOST_CHECK(D.at(i, j) == Q.at(i, j));
 }
 
+// Compares DBM::close on a random non-empty DBM with a plain Floyd-Warshall
+static void check_close(const dim_t dim) {
+    DBM D = DBM::unconstrained(dim);
+    std::vector<bound_t> ref(dim * dim);
+
+    // Bounds of the form v[i] - v[j] + slack keep the valuation v inside the zone, so it is non-empty
+    uint32_t seed = 42;
+    std::vector<val_t> v(dim, 0);
+    for (dim_t i = 1; i < dim; ++i) {
+        seed = seed * 1103515245 + 12345;
+        v[i] = (seed >> 8) % 40;
+    }
+    for (dim_t i = 0; i < dim; ++i)
+        for (dim_t j = 0; j < dim; ++j) {
+            seed = seed * 1103515245 + 12345;
+            if (i != j && (seed >> 16) % 3 != 0)
+                D.set(i, j, bound_t(v[i] - v[j] + (val_t) ((seed >> 8) % 20) + 1, ((seed >> 4) & 1) == 1));
+            ref[i * dim + j] = D.at(i, j);
+        }
+
+    for (dim_t k = 0; k < dim; ++k)
+        for (dim_t i = 0; i < dim; ++i)
+            for (dim_t j = 0; j < dim; ++j)
+                ref[i * dim + j] = bound_t::min(ref[i * dim + j], ref[i * dim + k] + ref[k * dim + j]);
+
+    D.close();
+
+    for (dim_t i = 0; i < dim; ++i)
+        for (dim_t j = 0; j < dim; ++j)
+            BOOST_CHECK(D.at(i, j) == ref[i * dim + j]);
+}
+
+BOOST_AUTO_TEST_CASE(close_test_2) {
+    // Dimension chosen so that both full vector lanes and the scalar tail are used
+    check_close(19);
+}
+
+BOOST_AUTO_TEST_CASE(close_test_3) {
+    // Dimensions handled by the fixed dimension kernels
+    for (dim_t dim = 1; dim <= 8; ++dim)
+        check_close(dim);
+}
+
+BOOST_AUTO_TEST_CASE(close_empty_test_1) {
+    // Fixed and plain closure
+    for (dim_t dim : {4u, 20u}) {
+        DBM D = DBM::unconstrained(dim);
+        D.set(1, 2, bound_t::non_strict(-3));
+        D.set(2, 3, bound_t::strict(3));
+        D.set(3, 1, bound_t::le_zero());
+        D.close();
+        BOOST_CHECK(D.is_empty());
+
+        DBM Q = DBM::unconstrained(dim);
+        Q.set(1, 2, bound_t::non_strict(-3));
+        Q.set(2, 3, bound_t::non_strict(3));
+        Q.set(3, 1, bound_t::le_zero());
+        Q.close();
+        BOOST_CHECK(not Q.is_empty());
+
+        std::vector<bound_t> bounds(dim * dim, bound_t::inf());
+        for (dim_t i = 0; i < dim; ++i)
+            bounds[i * dim + i] = bound_t::le_zero();
+        bounds[dim * (dim - 1) + dim - 2] = bound_t::strict(2);
+        bounds[dim * (dim - 2) + dim - 1] = bound_t::non_strict(-2);
+        BOOST_CHECK(not close_bounds(bounds.data(), dim));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(close_parallel_test_1) {
+    set_closure_threads(3);
+    BOOST_CHECK(closure_threads() == 3);
+    check_close(PARALLEL_CLOSURE_DIMENSION + 5);
+    set_closure_threads(1);
+}
+
+BOOST_AUTO_TEST_CASE(close_parallel_test_2) {
+    // A negative cycle between the last two clocks makes the result depend on the order of the updates
+    const dim_t dim = 150;
+    std::vector<bound_t> sequential(dim * dim);
+    uint32_t seed = 7;
+    for (dim_t i = 0; i < dim; ++i)
+        for (dim_t j = 0; j < dim; ++j) {
+            seed = seed * 1103515245 + 12345;
+            sequential[i * dim + j] = i == j ? bound_t::le_zero() : bound_t::non_strict((val_t) ((seed >> 8) % 50));
+        }
+    sequential[(dim - 2) * dim + dim - 1] = bound_t::non_strict(-3);
+    sequential[(dim - 1) * dim + dim - 2] = bound_t::strict(1);
+    std::vector<bound_t> parallel(sequential);
+
+    close_bounds(sequential.data(), dim);
+    BOOST_CHECK(sequential[(dim - 1) * dim + dim - 1] < bound_t::le_zero());
+    for (unsigned threads : {2u, 4u, 7u}) {
+        std::vector<bound_t> result(parallel);
+        close_bounds_parallel(result.data(), dim, threads);
+        BOOST_CHECK(result == sequential);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(close_parallel_test_3) {
+    // Closures started from several threads at once share the closure threads, or run on the calling thread
+    const dim_t dim = PARALLEL_CLOSURE_DIMENSION + 3;
+    std::vector<bound_t> bounds(dim * dim);
+    uint32_t seed = 11;
+    for (dim_t i = 0; i < dim; ++i)
+        for (dim_t j = 0; j < dim; ++j) {
+            seed = seed * 1103515245 + 12345;
+            bounds[i * dim + j] = i == j ? bound_t::le_zero() : bound_t::non_strict((val_t) ((seed >> 8) % 50));
+        }
+    std::vector<bound_t> sequential(bounds);
+    close_bounds(sequential.data(), dim);
+
+    std::vector<std::vector<bound_t>> results(4, bounds);
+    {
+        std::vector<std::jthread> callers;
+        for (unsigned c = 0; c < results.size(); ++c)
+            callers.emplace_back([&results, c, dim] {close_bounds_parallel(results[c].data(), dim, 2 + c);});
+    }
+    for (const auto& result : results)
+        BOOST_CHECK(result == sequential);
+}
+
+BOOST_AUTO_TEST_CASE(incremental_close_test_1) {
+    DBM D(12);
+    D.future();
+    for (dim_t x = 1; x < 12; ++x) {
+        D.restrict(x, 0, bound_t::non_strict(10 + (val_t) x));
+        D.restrict(0, x, bound_t::strict(-(val_t) x / 2));
+    }
+    D.restrict(3, 5, bound_t::non_strict(1));
+    D.restrict(7, 2, bound_t::strict(4));
+
+    // Tighten and loosen bounds in the rows and columns of clocks 2 and 9
+    DBM Q = D;
+    D.set(2, 9, bound_t::strict(3));
+    D.set(9, 0, bound_t::non_strict(12));
+    D.set(4, 2, bound_t::inf());
+    D.set(0, 9, bound_t::non_strict(-6));
+    Q.set(2, 9, bound_t::strict(3));
+    Q.set(9, 0, bound_t::non_strict(12));
+    Q.set(4, 2, bound_t::inf());
+    Q.set(0, 9, bound_t::non_strict(-6));
+
+    D.close({2, 9});
+    Q.close();
+
+    BOOST_CHECK(not D.is_empty());
+    for (dim_t i = 0; i < 12; ++i)
+        for (dim_t j = 0; j < 12; ++j)
+            BOOST_CHECK(D.at(i, j) == Q.at(i, j));
+}
+
+BOOST_AUTO_TEST_CASE(incremental_close_test_2) {
+    DBM D(12);
+    D.future();
+    D.restrict(1, 0, bound_t::non_strict(5));
+
+    // Clock 4 is now between 7 and 5, so the zone becomes empty
+    D.set(0, 4, bound_t::non_strict(-7));
+    D.close({4});
+
+    BOOST_CHECK(D.is_empty());
+}
+
+BOOST_AUTO_TEST_CASE(lazy_close_test_1) {
+    DBM D = DBM::unconstrained(6);
+    D.set_lazy(true);
+    D.set(1, 0, bound_t::non_strict(5));
+    D.set(2, 1, bound_t::non_strict(2));
+
+    DBM Q = DBM::unconstrained(6);
+    Q.restrict(1, 0, bound_t::non_strict(5));
+    Q.restrict(2, 1, bound_t::non_strict(2));
+
+    // Queries close D on demand, so x2 <= 7 is known without an explicit close()
+    BOOST_CHECK(not D.is_satisfying(0, 2, bound_t::non_strict(-8)));
+    BOOST_CHECK(D.is_satisfying(0, 2, bound_t::non_strict(-7)));
+    BOOST_CHECK(D.relation(Q).is_equal());
+    BOOST_CHECK(not D.is_unbounded());
+    BOOST_CHECK(D.at(2, 0) == bound_t::non_strict(7));
+
+    // Without lazy mode, queries read the bounds as they are until an operation or close() closes the DBM
+    DBM R = DBM::unconstrained(6);
+    R.set(1, 0, bound_t::non_strict(5));
+    R.set(2, 1, bound_t::non_strict(2));
+    BOOST_CHECK(not R.is_lazy());
+    BOOST_CHECK(R.is_satisfying(0, 2, bound_t::non_strict(-8)));
+    BOOST_CHECK(R.at(2, 0) == bound_t::inf());
+    R.close();
+    BOOST_CHECK(R.at(2, 0) == bound_t::non_strict(7));
+}
+
+BOOST_AUTO_TEST_CASE(lazy_close_test_2) {
+    DBM D = DBM::unconstrained(10);
+    D.set_lazy(true);
+    for (dim_t x = 1; x < 10; ++x)
+        D.restrict(x, 0, bound_t::non_strict(3 * (val_t) x));
+
+    // All bounds are in the row or column of clock 3, which is closed incrementally
+    DBM Q = D;
+    for (DBM* dbm : {&D, &Q}) {
+        dbm->set(3, 5, bound_t::strict(-2));
+        dbm->set(0, 3, bound_t::non_strict(-4));
+        dbm->set(7, 3, bound_t::inf());
+    }
+    std::vector<dim_t> all_clocks(10);
+    std::iota(all_clocks.begin(), all_clocks.end(), 0);
+    Q.close(all_clocks);
+
+    BOOST_CHECK(not Q.is_empty());
+    BOOST_CHECK(D.is_equal(Q));
+    for (dim_t i = 0; i < 10; ++i)
+        for (dim_t j = 0; j < 10; ++j)
+            BOOST_CHECK(D.at(i, j) == Q.at(i, j));
+
+    // A bound outside clock 3 requires a full closure
+    D.set(3, 0, bound_t::non_strict(5));
+    D.set(2, 1, bound_t::non_strict(-20));
+    BOOST_CHECK(D.is_empty());
+}
+
 BOOST_AUTO_TEST_CASE(future_test_1) {
     DBM D(10);
 
@@ -177,6 +403,47 @@ BOOST_AUTO_TEST_CASE(restrict_test_2) {
     BOOST_CHECK(D.is_empty());
 }
 
+BOOST_AUTO_TEST_CASE(restrict_test_3) {
+    DBM D = DBM::unconstrained(4);
+    D.restrict(difference_bound_t::lower_non_strict(3, 10));
+    D.restrict(2, 1, bound_t::le_zero());
+
+    // x1 >= x2 >= x3 >= 10 is a path through both clocks of the new bound
+    D.restrict(3, 2, bound_t::le_zero());
+    BOOST_CHECK(D.at(0, 1) == bound_t::non_strict(-10));
+    BOOST_CHECK(D.at(0, 2) == bound_t::non_strict(-10));
+}
+
+BOOST_AUTO_TEST_CASE(restrict_batch_test_1) {
+    DBM D = DBM::unconstrained(14), Q = DBM::unconstrained(14);
+
+    std::vector<difference_bound_t> guard{difference_bound_t::upper_non_strict(1, 10),
+                                          difference_bound_t::lower_strict(2, 3),
+                                          difference_bound_t(3, 4, bound_t::strict(2)),
+                                          difference_bound_t::upper_strict(5, 8),
+                                          difference_bound_t::lower_non_strict(6, 1),
+                                          difference_bound_t(7, 2, bound_t::non_strict(-1))};
+
+    D.restrict(guard);
+    for (const auto& c : guard)
+        Q.restrict(c);
+
+    BOOST_CHECK(not D.is_empty());
+    BOOST_CHECK(D.is_equal(Q));
+}
+
+BOOST_AUTO_TEST_CASE(restrict_batch_test_2) {
+    DBM D = DBM::unconstrained(5);
+
+    // Each constraint is satisfiable on its own, but not together
+    D.restrict({difference_bound_t::upper_non_strict(1, 5),
+                difference_bound_t(2, 1, bound_t::strict(-1)),
+                difference_bound_t::lower_non_strict(2, 6),
+                difference_bound_t::upper_strict(3, 7)});
+
+    BOOST_CHECK(D.is_empty());
+}
+
 BOOST_AUTO_TEST_CASE(subtract_test_1) {
     DBM D(3);
     bound_t g = bound_t::inf();
@@ -795,6 +1062,31 @@ BOOST_AUTO_TEST_CASE(extrapolate_lu_test_1) {
     BOOST_CHECK(D.at(2, 2) == bound_t::le_zero());
 }
 
+BOOST_AUTO_TEST_CASE(extrapolate_lu_test_2) {
+    // Too large for the fixed dimension kernels, so the bounds are updated in place
+    DBM D = DBM::unconstrained(10);
+    for (dim_t x = 1; x < 10; ++x) {
+        D.restrict(x, 0, bound_t::non_strict(20 + (val_t) x));
+        D.restrict(0, x, bound_t::non_strict(-5));
+    }
+    D.restrict(0, 9, bound_t::non_strict(-15));
+    D.restrict(3, 4, bound_t::strict(2));
+
+    std::vector<val_t> bounds(10, 10);
+    bounds[0] = 0;
+    D.extrapolate_lu(bounds, bounds);
+
+    for (dim_t x = 1; x < 9; ++x) {
+        BOOST_CHECK(D.at(x, 0) == bound_t::inf());
+        BOOST_CHECK(D.at(0, x) == bound_t::non_strict(-5));
+    }
+    BOOST_CHECK(D.at(9, 0) == bound_t::inf());
+    BOOST_CHECK(D.at(0, 9) == bound_t::strict(-10));
+    BOOST_CHECK(D.at(3, 4) == bound_t::strict(2));
+    BOOST_CHECK(D.at(4, 3) == bound_t::inf());
+    BOOST_CHECK(not D.is_empty());
+}
+
 BOOST_AUTO_TEST_CASE(extrapolate_lu_diagonal_test_1) {
     /* Diagonal LU Extrapolation
      * Example from Behrmann, Gerd & Bouyer, Patricia & Larsen, Kim & Pelánek, Radek. (2004).
@@ -837,6 +1129,106 @@ BOOST_AUTO_TEST_CASE(extrapolate_lu_diagonal_test_1) {
     BOOST_CHECK(D.at(2, 2) == bound_t::le_zero());
 }
 
+BOOST_AUTO_TEST_CASE(extrapolate_lu_diagonal_test_2) {
+    // The upper bound of x is below L and must be kept
+    DBM D = DBM::unconstrained(2);
+    D.restrict(1, 0, bound_t::non_strict(4));
+    DBM E = D;
+
+    D.extrapolate_lu_diagonal({0, 7}, {0, 1});
+    E.extrapolate(extrapolation_t::lu_diagonal({0, 7}, {0, 1}));
+
+    BOOST_CHECK(D.at(1, 0) == bound_t::non_strict(4));
+    BOOST_CHECK(D.at(0, 1) == bound_t::le_zero());
+    BOOST_CHECK(E.is_equal(D));
+}
+
+BOOST_AUTO_TEST_CASE(is_included_lu_test_1) {
+    // The zone from extrapolate_lu_diagonal_test_1
+    DBM D(3);
+    D.set(0, 1, bound_t::non_strict(-2));
+    D.set(0, 2, bound_t::non_strict(-2));
+    D.set(1, 0, bound_t::non_strict(5));
+    D.set(1, 2, bound_t::le_zero());
+    D.set(2, 0, bound_t::non_strict(7));
+    D.set(2, 1, bound_t::non_strict(2));
+
+    std::vector<val_t> upper {0, 1, 7};
+    std::vector<val_t> lower {0, 1, 1};
+
+    // Extra+LU(D) is included in aLU(D)
+    DBM E = D;
+    E.extrapolate_lu_diagonal(lower, upper);
+    BOOST_CHECK(E.is_included_lu(D, lower, upper));
+    BOOST_CHECK(D.is_included_lu(D, lower, upper));
+    BOOST_CHECK(D.is_included_lu(E, lower, upper));
+    BOOST_CHECK(not E.is_subset(D));
+
+    // x = y = 0 is below the upper bound 1 of x, and no valuation of D has x <= 1
+    BOOST_CHECK(not DBM::unconstrained(3).is_included_lu(D, lower, upper));
+
+    // Without bounds on any clock every non-empty zone simulates every zone
+    std::vector<val_t> none {0, -1, -1};
+    BOOST_CHECK(DBM::unconstrained(3).is_included_lu(D, none, none));
+
+    DBM empty(3);
+    empty.restrict(1, 0, bound_t::strict(0));
+    BOOST_CHECK(empty.is_included_lu(D, lower, upper));
+    BOOST_CHECK(not D.is_included_lu(empty, lower, upper));
+}
+
+BOOST_AUTO_TEST_CASE(is_included_lu_test_3) {
+    // The constants of the zero clock are ignored
+    DBM D(3);
+    D.set(0, 1, bound_t::non_strict(-2));
+    D.set(0, 2, bound_t::non_strict(-2));
+    D.set(1, 0, bound_t::non_strict(5));
+    D.set(1, 2, bound_t::le_zero());
+    D.set(2, 0, bound_t::non_strict(7));
+    D.set(2, 1, bound_t::non_strict(2));
+    DBM E = D;
+    E.extrapolate_lu_diagonal({0, 1, 1}, {0, 1, 7});
+
+    for (val_t c : {-1, 3}) {
+        std::vector<val_t> lower {c, 1, 1}, upper {c, 1, 7};
+        BOOST_CHECK(E.is_included_lu(D, lower, upper));
+        BOOST_CHECK(not DBM::unconstrained(3).is_included_lu(D, lower, upper));
+        BOOST_CHECK(DBM::unconstrained(3).is_included_lu(D, {c, -1, -1}, {c, -1, -1}));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(is_included_lu_test_2) {
+    // Random zones: subsets and LU-extrapolations of a zone are included in its abstraction
+    uint32_t seed = 7;
+    auto next = [&seed](val_t n) {seed = seed * 1103515245 + 12345; return (val_t) ((seed >> 8) % n);};
+
+    for (int n = 0; n < 50; ++n) {
+        const dim_t dim = 2 + next(8);
+        std::vector<val_t> v(dim, 0), lower(dim, 0), upper(dim, 0);
+        for (dim_t i = 1; i < dim; ++i) {
+            v[i] = next(20);
+            lower[i] = next(25) - 3;
+            upper[i] = next(25) - 3;
+        }
+
+        DBM D = DBM::unconstrained(dim);
+        for (dim_t i = 0; i < dim; ++i)
+            for (dim_t j = 0; j < dim; ++j)
+                if (i != j && next(3) == 0)
+                    D.restrict(i, j, bound_t::non_strict(v[i] - v[j] + next(6)));
+
+        DBM E = D, S = D;
+        E.extrapolate_lu_diagonal(lower, upper);
+        S.restrict(1, 0, bound_t::non_strict(v[1]));
+
+        BOOST_CHECK(E.is_included_lu(D, lower, upper));
+        BOOST_CHECK(S.is_included_lu(D, lower, upper));
+        BOOST_CHECK(D.is_included_lu(D, lower, upper));
+        if (not D.is_included_lu(S, lower, upper))
+            BOOST_CHECK(not D.is_subset(S));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(intersection_test_1) {
     auto dbm1 = DBM::zero(3);
     auto dbm2 = DBM::zero(3);
@@ -884,6 +1276,122 @@ BOOST_AUTO_TEST_CASE(intersection_test_3) {
     BOOST_CHECK(not dbm2.is_intersecting(dbm1));
 }
 
+BOOST_AUTO_TEST_CASE(intersection_test_4) {
+    // x1 - x2 <= -3 and x2 - x1 <= -2 are both negative
+    auto dbm1 = DBM::unconstrained(3);
+    auto dbm2 = DBM::unconstrained(3);
+    dbm1.restrict(1, 2, bound_t::non_strict(-3));
+    dbm2.restrict(2, 1, bound_t::non_strict(-2));
+
+    BOOST_CHECK(not dbm1.is_intersecting(dbm2));
+    BOOST_CHECK(not dbm2.is_intersecting(dbm1));
+
+    dbm2.restrict(2, 1, bound_t::non_strict(3));
+    dbm2.free(2);
+    dbm2.restrict(2, 1, bound_t::non_strict(3));
+    BOOST_CHECK(dbm1.is_intersecting(dbm2));
+}
+
+BOOST_AUTO_TEST_CASE(convex_union_test_1) {
+    auto dbm1 = DBM::unconstrained(3);
+    auto dbm2 = DBM::unconstrained(3);
+    dbm1.restrict({difference_bound_t::upper_non_strict(1, 2), difference_bound_t::upper_non_strict(2, 2)});
+    dbm2.restrict({difference_bound_t::lower_non_strict(1, 5), difference_bound_t::upper_strict(1, 7),
+                   difference_bound_t::lower_non_strict(2, 5), difference_bound_t::upper_non_strict(2, 6)});
+
+    auto hull = dbm1;
+    hull.convex_union(dbm2);
+
+    BOOST_CHECK(dbm1.is_subset(hull) && dbm2.is_subset(hull));
+    BOOST_CHECK(hull.at(1, 0) == bound_t::strict(7));
+    BOOST_CHECK(hull.at(2, 0) == bound_t::non_strict(6));
+    BOOST_CHECK(hull.at(0, 1) == bound_t::le_zero());
+    BOOST_CHECK(hull.at(1, 2) == bound_t::non_strict(2));
+
+    // The hull is closed
+    auto closed = hull;
+    closed.close();
+    BOOST_CHECK(closed.is_equal(hull));
+
+    auto empty = DBM::unconstrained(3);
+    empty.restrict(1, 0, bound_t::strict(0));
+    auto copy = dbm1;
+    copy.convex_union(empty);
+    BOOST_CHECK(copy.is_equal(dbm1));
+    empty.convex_union(dbm2);
+    BOOST_CHECK(empty.is_equal(dbm2));
+}
+
+BOOST_AUTO_TEST_CASE(minimal_constraints_test_1) {
+    auto dbm = DBM::unconstrained(3);
+    dbm.restrict({difference_bound_t::lower_non_strict(1, 3), difference_bound_t::upper_non_strict(1, 4),
+                  difference_bound_t::lower_strict(2, 3), difference_bound_t::upper_non_strict(2, 4)});
+
+    // The differences between the clocks are implied by their bounds
+    const auto constraints = dbm.minimal_constraints();
+    BOOST_CHECK_EQUAL(constraints.size(), 4);
+
+    auto restricted = DBM::unconstrained(3);
+    restricted.restrict(constraints);
+    BOOST_CHECK(restricted.is_equal(dbm));
+
+    // Equal clocks are given by a cycle, and x >= 0 is left out
+    dbm = DBM::unconstrained(3);
+    dbm.restrict({difference_bound_t(1, 2, bound_t::le_zero()), difference_bound_t(2, 1, bound_t::le_zero()),
+                  difference_bound_t::upper_non_strict(1, 5)});
+    BOOST_CHECK_EQUAL(dbm.minimal_constraints().size(), 3);
+
+    restricted = DBM::unconstrained(3);
+    restricted.restrict(dbm.minimal_constraints());
+    BOOST_CHECK(restricted.is_equal(dbm));
+
+    dbm.restrict(1, 0, bound_t::strict(0));
+    restricted = DBM::unconstrained(3);
+    restricted.restrict(dbm.minimal_constraints());
+    BOOST_CHECK(restricted.is_empty());
+}
+
+BOOST_AUTO_TEST_CASE(minimal_constraints_test_2) {
+    // Random zones, some with clocks fixed to each other, are given by their constraints, and none can be left out
+    uint32_t seed = 7;
+    auto next = [&seed](uint32_t n) {seed = seed * 1103515245 + 12345; return (seed >> 8) % n;};
+
+    for (int round = 0; round < 50; ++round) {
+        const dim_t dim = 2 + next(6);
+        std::vector<val_t> v(dim, 0);
+        for (dim_t i = 1; i < dim; ++i)
+            v[i] = next(3) == 0 && i > 1 ? v[i - 1] : (val_t) next(20);
+
+        // Bounds of the form v[i] - v[j] + slack keep the valuation v inside the zone
+        auto dbm = DBM::unconstrained(dim);
+        for (dim_t i = 0; i < dim; ++i) {
+            for (dim_t j = 0; j < dim; ++j) {
+                if (i == j || next(3) != 0) continue;
+                const val_t slack = (val_t) next(4);
+                dbm.restrict(i, j, bound_t(v[i] - v[j] + slack, slack > 0 && next(2) == 0));
+            }
+            if (i > 1 && v[i] == v[i - 1]) {
+                dbm.restrict(i, i - 1, bound_t::le_zero());
+                dbm.restrict(i - 1, i, bound_t::le_zero());
+            }
+        }
+        BOOST_REQUIRE(not dbm.is_empty());
+
+        const auto constraints = dbm.minimal_constraints();
+        auto restricted = DBM::unconstrained(dim);
+        restricted.restrict(constraints);
+        BOOST_CHECK(restricted.is_equal(dbm));
+
+        for (size_t k = 0; k < constraints.size(); ++k) {
+            auto without = constraints;
+            without.erase(without.begin() + k);
+            restricted = DBM::unconstrained(dim);
+            restricted.restrict(without);
+            BOOST_CHECK(not restricted.is_equal(dbm));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(is_unbounded_test_1) {
     DBM D(3);
     BOOST_CHECK(!D.is_unbounded());
@@ -980,6 +1488,62 @@ BOOST_AUTO_TEST_CASE(relation_test_4) {
     BOOST_CHECK(a.is_equal(b));
 }
 
+BOOST_AUTO_TEST_CASE(relation_test_5) {
+    // Dimensions without a fixed kernel, with and without a tail after the last full vector
+    for (dim_t dim : {dim_t(9), dim_t(16), dim_t(21)}) {
+        DBM D = DBM::unconstrained(dim);
+        for (dim_t i = 1; i < dim; ++i)
+            D.restrict(i, 0, bound_t::non_strict(10 + i));
+        DBM E = D;
+
+        BOOST_CHECK(D.relation(E).is_equal());
+
+        // Looser bound in the last column of the last row
+        E.restrict(dim - 1, 0, bound_t::non_strict(5));
+        E.free(dim - 1);
+        BOOST_CHECK(D.relation(E).is_subset());
+        BOOST_CHECK(E.relation(D).is_superset());
+
+        // Tighter bound in the first row
+        DBM F = D;
+        F.restrict(0, 1, bound_t::non_strict(-1));
+        BOOST_CHECK(F.relation(E).is_subset());
+        BOOST_CHECK(F.relation(D).is_subset());
+
+        F.restrict(dim - 1, 0, bound_t::strict(dim));
+        F.free(1);
+        BOOST_CHECK(F.relation(D).is_different());
+        BOOST_CHECK(D.relation(F).is_different());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(compare_bounds_test_1) {
+    for (dim_t dim : {dim_t(1), dim_t(3), dim_t(4), dim_t(8), dim_t(13), dim_t(24)}) {
+        std::vector<bound_t> lhs(dim * dim, bound_t::non_strict(3)), rhs = lhs;
+        bool subset = false, superset = false;
+
+        compare_bounds(lhs.data(), rhs.data(), dim, subset, superset);
+        BOOST_CHECK(subset && superset);
+
+        // Every position, so each lane of the vector kernels and the scalar tail is checked
+        for (dim_t c = 0; c < dim * dim; ++c) {
+            rhs[c] = bound_t::inf();
+            compare_bounds(lhs.data(), rhs.data(), dim, subset, superset);
+            BOOST_CHECK(subset && not superset);
+
+            compare_bounds(rhs.data(), lhs.data(), dim, subset, superset);
+            BOOST_CHECK(not subset && superset);
+
+            lhs[dim * dim - 1 - c] = bound_t::strict(3);
+            compare_bounds(lhs.data(), rhs.data(), dim, subset, superset);
+            BOOST_CHECK(subset && not superset);
+
+            lhs[dim * dim - 1 - c] = bound_t::non_strict(3);
+            rhs[c] = bound_t::non_strict(3);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(relation_t_test_1) {
     DBM a(10), b(10);
 
@@ -1061,4 +1625,43 @@ BOOST_AUTO_TEST_CASE(unconstrained_test_1) {
     }
 
     BOOST_CHECK(DBM::unconstrained(dimension).is_equal(dbm));
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(hash_test_1) {
+    for (dim_t dim : {dim_t(3), dim_t(12)}) {
+        // The same zone built in different orders, and through a non-canonical set()
+        DBM D = DBM::unconstrained(dim), E = DBM::unconstrained(dim);
+        D.restrict(1, 0, bound_t::non_strict(5));
+        D.restrict(2, 1, bound_t::strict(3));
+        E.restrict(2, 1, bound_t::strict(3));
+        E.set(1, 0, bound_t::non_strict(5));
+        E.close();
+
+        BOOST_CHECK(D.is_equal(E));
+        BOOST_CHECK_EQUAL(D.hash(), E.hash());
+        BOOST_CHECK_EQUAL(std::hash<DBM>{}(D), D.hash());
+
+        // Kept up to date through operations after the first hash
+        DBM F = D;
+        F.future();
+        BOOST_CHECK(F.hash() != D.hash());
+        D.future();
+        BOOST_CHECK_EQUAL(F.hash(), D.hash());
+
+        D.set(1, 0, bound_t::non_strict(5));
+        D.close();
+        BOOST_CHECK(F.hash() != D.hash());
+        BOOST_CHECK_EQUAL(D.hash(), DBM(D).hash());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hash_empty_test_1) {
+    DBM D = DBM::unconstrained(4), E = DBM::unconstrained(4);
+    D.restrict(1, 0, bound_t::strict(0));
+    E.restrict(2, 3, bound_t::non_strict(-2));
+    E.restrict(3, 2, bound_t::non_strict(1));
+
+    BOOST_CHECK(D.is_empty() && E.is_empty());
+    BOOST_CHECK_EQUAL(D.hash(), E.hash());
+    BOOST_CHECK(D.hash() != DBM::unconstrained(4).hash());
+}
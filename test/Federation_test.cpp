@@ -26,6 +26,8 @@
 #include "pardibaal/Federation.h"
 #include "errors.h"
 
+#include <memory_resource>
+
 using namespace pardibaal;
 
 BOOST_AUTO_TEST_CASE(at_test_1) {
@@ -122,6 +124,277 @@ BOOST_AUTO_TEST_CASE(subtract_test_2) {
 
 }
 
+BOOST_AUTO_TEST_CASE(subtract_test_3) {
+    // Subtracting an interval from the middle leaves both sides
+    auto fed = Federation::unconstrained(2);
+    fed.restrict(difference_bound_t::upper_non_strict(1, 10));
+
+    auto dbm = DBM::unconstrained(2);
+    dbm.restrict(difference_bound_t::upper_non_strict(1, 5));
+    dbm.restrict(difference_bound_t::lower_non_strict(1, 3));
+
+    fed.subtract(dbm);
+
+    BOOST_CHECK(fed.is_satisfying(difference_bound_t::upper_strict(1, 3)));
+    BOOST_CHECK(fed.is_satisfying(difference_bound_t::lower_strict(1, 5)));
+    BOOST_CHECK_EQUAL(fed.size(), 2);
+
+    fed.intersection(dbm);
+    BOOST_CHECK(fed.is_empty());
+}
+
+namespace {
+    // x1 in [lower, upper] and x2 in [lower2, upper2]
+    DBM box(val_t lower, val_t upper, val_t lower2 = 0, val_t upper2 = 100) {
+        auto dbm = DBM::unconstrained(3);
+        dbm.restrict({difference_bound_t::lower_non_strict(1, lower), difference_bound_t::upper_non_strict(1, upper),
+                      difference_bound_t::lower_non_strict(2, lower2), difference_bound_t::upper_non_strict(2, upper2)});
+        return dbm;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reduce_test_1) {
+    Federation fed(box(0, 5));
+    fed.add(box(3, 8));
+    fed.add(box(2, 6));
+    fed.add(box(1, 2, 200, 300));
+    BOOST_CHECK_EQUAL(fed.size(), 4);
+
+    const auto original = fed;
+    fed.reduce();
+
+    // [2, 6] is only included in the union of [0, 5] and [3, 8]
+    BOOST_CHECK_EQUAL(fed.size(), 3);
+    BOOST_CHECK(fed.is_exact_equal(original));
+}
+
+BOOST_AUTO_TEST_CASE(merge_test_1) {
+    Federation fed(box(0, 5));
+    fed.add(box(5, 8));
+    fed.add(box(10, 12));
+
+    const auto original = fed;
+    fed.merge();
+
+    // Adjacent intervals are merged, the gap between 8 and 10 is kept
+    BOOST_CHECK_EQUAL(fed.size(), 2);
+    BOOST_CHECK(fed.is_exact_equal(original));
+    BOOST_CHECK(not fed.is_exact_equal(Federation(box(0, 8))));
+
+    Federation expected(box(0, 8));
+    expected.add(box(10, 12));
+    BOOST_CHECK(fed.is_exact_equal(expected));
+}
+
+BOOST_AUTO_TEST_CASE(merge_test_2) {
+    // An L-shape is not convex, so it cannot be merged
+    Federation fed(box(0, 10, 0, 5));
+    fed.add(box(0, 5, 0, 10));
+    fed.merge();
+    BOOST_CHECK_EQUAL(fed.size(), 2);
+
+    // The fragments of a subtraction are merged back into the zone
+    auto whole = box(0, 10, 0, 10);
+    Federation fragments(whole);
+    fragments.subtract(box(3, 4, 0, 10));
+    fragments.add(box(3, 4, 0, 10));
+    BOOST_CHECK(fragments.size() > 1);
+
+    fragments.merge();
+    BOOST_CHECK_EQUAL(fragments.size(), 1);
+    BOOST_CHECK(fragments.at(0).is_equal(whole));
+}
+
+BOOST_AUTO_TEST_CASE(subtract_test_4) {
+    // Only the minimal constraints of the subtrahend give fragments, and not the differences implied by the bounds
+    auto whole = box(0, 10, 0, 10);
+    Federation fed(whole), disjoint(whole);
+    fed.subtract(box(3, 4, 3, 4));
+    disjoint.subtract_disjoint(box(3, 4, 3, 4));
+    BOOST_CHECK_EQUAL(fed.size(), 4);
+    BOOST_CHECK_EQUAL(disjoint.size(), 4);
+    BOOST_CHECK(fed.is_exact_equal(disjoint));
+
+    // x1 == x2 <= 5 has three minimal constraints, but its upper bound on x2 is implied
+    auto diagonal = DBM::unconstrained(3);
+    diagonal.restrict({difference_bound_t(1, 2, bound_t::le_zero()), difference_bound_t(2, 1, bound_t::le_zero()),
+                       difference_bound_t::upper_non_strict(1, 5)});
+    fed = Federation(whole);
+    fed.subtract(diagonal);
+    BOOST_CHECK(fed.size() <= 3);
+    BOOST_CHECK(not fed.is_intersecting(diagonal));
+
+    auto both = fed;
+    both.add(diagonal);
+    BOOST_CHECK(both.is_exact_equal(whole));
+}
+
+BOOST_AUTO_TEST_CASE(is_including_test_1) {
+    // [0, 10] is covered by [0, 5] and [5, 10] together, but not by either
+    Federation fed(box(0, 5));
+    fed.add(box(5, 10));
+    fed.add(box(20, 30));
+
+    BOOST_CHECK(fed.is_including(box(0, 10)));
+    BOOST_CHECK(fed.is_including(box(2, 7)));
+    BOOST_CHECK(not fed.is_including(box(0, 11)));
+    BOOST_CHECK(not fed.is_including(box(0, 10, 0, 101)));
+    BOOST_CHECK(not fed.is_included(box(0, 10)));
+    BOOST_CHECK(fed.is_included(box(0, 30)));
+
+    BOOST_CHECK(box(0, 10).is_exact_subset(fed));
+    BOOST_CHECK(fed.is_exact_superset(box(0, 10)));
+    BOOST_CHECK(not fed.is_exact_equal(box(0, 30)));
+    BOOST_CHECK(fed.is_exact_subset(box(0, 30)));
+    BOOST_CHECK(fed.exact_relation(box(0, 11)).is_different());
+
+    Federation two(box(0, 5));
+    two.add(box(5, 10));
+    BOOST_CHECK(two.is_exact_equal(box(0, 10)));
+    BOOST_CHECK(box(0, 10).is_exact_equal(two));
+    BOOST_CHECK(two.exact_relation(box(0, 10)).is_equal());
+
+    auto empty = box(0, 10);
+    empty.restrict(1, 0, bound_t::strict(0));
+    BOOST_CHECK(fed.is_including(empty));
+    BOOST_CHECK(fed.exact_relation(empty).is_superset());
+    BOOST_CHECK(Federation().exact_relation(empty).is_equal());
+    BOOST_CHECK(Federation().exact_relation(box(0, 10)).is_subset());
+}
+
+BOOST_AUTO_TEST_CASE(is_including_test_2) {
+    // Compares with subtracting the federation from the zone, on random boxes with a diagonal constraint.
+    // The federation is the fragments of the zone outside another zone and that zone, with one of them left out.
+    uint32_t seed = 3;
+    auto next = [&seed](uint32_t n) {seed = seed * 1103515245 + 12345; return (val_t) ((seed >> 8) % n);};
+    auto random_zone = [&next]() {
+        const val_t x = next(10), y = next(10);
+        auto zone = box(x, x + next(8), y, y + next(8));
+        zone.restrict(1, 2, bound_t(next(12) - 4, next(2) == 0));
+        return zone;
+    };
+
+    for (int round = 0; round < 200; ++round) {
+        const auto dbm = random_zone(), cut = random_zone();
+        Federation fed(dbm);
+        fed.subtract(cut);
+        fed.add(cut);
+        if (next(2) == 0 && fed.size() > 1)
+            fed.remove(next(fed.size()));
+
+        Federation difference(dbm);
+        difference.subtract(fed);
+        BOOST_CHECK_EQUAL(fed.is_including(dbm), difference.is_empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(is_including_test_3) {
+    // Zones of different dimensions are different, also when one of them is empty
+    Federation fed(box(0, 10));
+    const auto other = DBM::unconstrained(4);
+    auto empty = DBM::unconstrained(4);
+    empty.restrict(1, 0, bound_t::strict(0));
+
+    BOOST_CHECK(fed.exact_relation(other).is_different());
+    BOOST_CHECK(other.exact_relation(fed).is_different());
+    BOOST_CHECK(fed.exact_relation(empty).is_different());
+    BOOST_CHECK(not fed.is_exact_superset(empty));
+    BOOST_CHECK(Federation().exact_relation(other).is_subset());
+
+#ifndef NEXCEPTIONS
+    BOOST_CHECK_THROW((void) fed.is_including(other), base_error);
+    BOOST_CHECK_THROW((void) fed.is_included(other), base_error);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(subtract_disjoint_test_1) {
+    auto whole = box(0, 10, 0, 10);
+    Federation fed(whole), expected(whole);
+    BOOST_CHECK(fed.is_disjoint());
+
+    fed.subtract_disjoint(box(3, 4, 3, 4));
+    expected.subtract(box(3, 4, 3, 4));
+    BOOST_CHECK(fed.is_disjoint());
+    BOOST_CHECK(fed.is_exact_equal(expected));
+
+    for (dim_t i = 0; i < fed.size(); ++i)
+        for (dim_t j = i + 1; j < fed.size(); ++j)
+            BOOST_CHECK(not fed.at(i).is_intersecting(fed.at(j)));
+
+    // A zone outside the subtrahend is kept as it is
+    fed.subtract_disjoint(box(20, 30));
+    BOOST_CHECK(fed.is_exact_equal(expected));
+
+    fed.subtract_disjoint(Federation(whole));
+    BOOST_CHECK(fed.is_empty());
+}
+
+BOOST_AUTO_TEST_CASE(subtract_disjoint_test_2) {
+    Federation fed(box(0, 5));
+    fed.add(box(10, 12));
+    BOOST_CHECK(fed.is_disjoint());
+
+    fed.add(box(4, 6));
+    BOOST_CHECK(not fed.is_disjoint());
+
+    // Subtraction keeps the fragments of overlapping zones, which may overlap
+    Federation expected = fed;
+    fed.subtract_disjoint(box(5, 11));
+    expected.subtract(box(5, 11));
+    BOOST_CHECK(not fed.is_disjoint());
+    BOOST_CHECK(fed.is_exact_equal(expected));
+
+    // Zones that only shrink stay disjoint, zones that grow may overlap
+    Federation disjoint(box(0, 5));
+    disjoint.add(box(10, 12));
+    disjoint.restrict(difference_bound_t::upper_non_strict(2, 50));
+    disjoint.delay(1);
+    BOOST_CHECK(disjoint.is_disjoint());
+    disjoint.future();
+    BOOST_CHECK(not disjoint.is_disjoint());
+}
+
+BOOST_AUTO_TEST_CASE(max_size_test_1) {
+    Federation fed(box(0, 1));
+    fed.set_max_size(2);
+    fed.add(box(2, 3));
+    BOOST_CHECK_EQUAL(fed.size(), 2);
+
+    // The two closest zones are replaced by their convex union
+    fed.add(box(50, 51));
+    BOOST_CHECK_EQUAL(fed.size(), 2);
+    BOOST_CHECK_EQUAL(fed.max_size(), 2);
+
+    Federation expected(box(0, 3));
+    expected.add(box(50, 51));
+    BOOST_CHECK(fed.is_exact_equal(expected));
+
+    // A limit below the size is applied immediately
+    fed.set_max_size(1);
+    BOOST_CHECK_EQUAL(fed.size(), 1);
+    BOOST_CHECK(fed.at(0).is_equal(box(0, 51)));
+}
+
+BOOST_AUTO_TEST_CASE(max_size_test_2) {
+    auto whole = box(0, 10, 0, 10);
+    Federation exact(whole), capped(whole);
+    capped.set_max_size(2);
+
+    exact.subtract(box(3, 4, 3, 4));
+    capped.subtract(box(3, 4, 3, 4));
+    BOOST_CHECK_EQUAL(exact.size(), 4);
+    BOOST_CHECK(capped.size() <= 2);
+
+    // The capped federation over-approximates the difference, and the exact relation still sees that
+    BOOST_CHECK(exact.is_exact_subset(capped));
+
+    // Copies keep the limit
+    Federation copy(capped, capped.get_allocator());
+    BOOST_CHECK_EQUAL(copy.max_size(), 2);
+    copy.intersection(Federation(whole));
+    BOOST_CHECK(copy.size() <= 2);
+}
+
 BOOST_AUTO_TEST_CASE(remove_test_1) {
     Federation fed(3);
 
@@ -796,3 +1069,41 @@ BOOST_AUTO_TEST_CASE(something) {
     BOOST_CHECK(rel12.is_different());
     BOOST_CHECK(rel21.is_different());
 }
+
+namespace {
+    // Sets the default memory resource, and restores the previous one also when a check throws
+    struct default_resource_guard {
+        std::pmr::memory_resource* previous;
+
+        explicit default_resource_guard(std::pmr::memory_resource* resource)
+                : previous(std::pmr::set_default_resource(resource)) {}
+        ~default_resource_guard() {std::pmr::set_default_resource(previous);}
+    };
+}
+
+BOOST_AUTO_TEST_CASE(pmr_test_1) {
+    // Everything must be allocated from the arena, so the default resource is set to fail on any allocation
+    std::vector<std::byte> buffer(1 << 20);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    {
+        default_resource_guard guard(std::pmr::null_memory_resource());
+        const dim_t dim = bounds_table_t::INLINE_DIMENSION + 2;
+        Federation fed(&arena);
+        fed.add(DBM::unconstrained(dim, &arena));
+        BOOST_CHECK(fed.get_allocator().resource() == &arena);
+        BOOST_CHECK(fed.at(0).get_allocator().resource() == &arena);
+
+        DBM dbm(dim, &arena);
+        dbm.future();
+        dbm.restrict(difference_bound_t::upper_non_strict(1, 5));
+
+        fed.subtract(dbm);
+        fed.restrict(difference_bound_t::upper_strict(2, 10));
+        fed.intersection(DBM::unconstrained(dim, &arena));
+
+        BOOST_CHECK(not fed.is_empty());
+        for (const auto& z : fed)
+            BOOST_CHECK(z.get_allocator().resource() == &arena);
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#define BOOST_TEST_MODULE PARDIBAAL
+
+#include <boost/test/unit_test.hpp>
+#include "pardibaal/ZoneStore.h"
+
+#include <memory_resource>
+
+using namespace pardibaal;
+
+namespace {
+    // x1 in [lower, upper], the remaining clocks unconstrained
+    DBM interval(dim_t dim, val_t lower, val_t upper) {
+        DBM D = DBM::unconstrained(dim);
+        D.restrict(1, 0, bound_t::non_strict(upper));
+        D.restrict(0, 1, bound_t::non_strict(-lower));
+        return D;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(zone_store_insert_test_1) {
+    ZoneStore store;
+    BOOST_CHECK(store.is_empty());
+
+    BOOST_CHECK(store.insert(1, interval(3, 2, 4)));
+    BOOST_CHECK(store.insert(1, interval(3, 6, 8)));
+    BOOST_CHECK_EQUAL(store.size(), 2);
+
+    // Duplicates and included zones are covered
+    BOOST_CHECK(not store.insert(1, interval(3, 2, 4)));
+    BOOST_CHECK(not store.insert(1, interval(3, 3, 4)));
+    BOOST_CHECK(store.is_covered(1, interval(3, 6, 7)));
+    BOOST_CHECK(not store.is_covered(1, interval(3, 4, 6)));
+    BOOST_CHECK_EQUAL(store.size(), 2);
+
+    // Other keys are independent
+    BOOST_CHECK(not store.is_covered(2, interval(3, 2, 4)));
+    BOOST_CHECK(store.insert(2, interval(3, 2, 4)));
+    BOOST_CHECK_EQUAL(store.size(), 3);
+    BOOST_CHECK_EQUAL(store.number_of_keys(), 2);
+
+    // A zone including both stored zones of key 1 replaces them
+    BOOST_CHECK(store.insert(1, interval(3, 1, 9)));
+    BOOST_CHECK_EQUAL(store.zones(1).size(), 1);
+    BOOST_CHECK(store.zones(1)[0].is_equal(interval(3, 1, 9)));
+    BOOST_CHECK_EQUAL(store.size(), 2);
+
+    store.erase(1);
+    BOOST_CHECK(store.zones(1).empty());
+    BOOST_CHECK_EQUAL(store.size(), 1);
+
+    store.clear();
+    BOOST_CHECK(store.is_empty());
+    BOOST_CHECK_EQUAL(store.number_of_keys(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(zone_store_insert_test_2) {
+    ZoneStore store;
+
+    // Empty zones are always covered
+    DBM empty = DBM::unconstrained(3);
+    empty.restrict(1, 0, bound_t::strict(0));
+    BOOST_CHECK(store.is_covered(1, empty));
+    BOOST_CHECK(not store.insert(1, empty));
+    BOOST_CHECK(store.is_empty());
+
+    // The stored zones stay pairwise incomparable
+    for (val_t n = 0; n < 20; ++n)
+        store.insert(1, interval(3, n % 7, n % 7 + n % 3));
+
+    auto zones = store.zones(1);
+    for (size_t i = 0; i < zones.size(); ++i)
+        for (size_t j = 0; j < zones.size(); ++j)
+            if (i != j)
+                BOOST_CHECK(zones[i].relation(zones[j]).is_different());
+
+    for (val_t n = 0; n < 20; ++n)
+        BOOST_CHECK(store.is_covered(1, interval(3, n % 7, n % 7 + n % 3)));
+}
+
+BOOST_AUTO_TEST_CASE(zone_store_allocator_test_1) {
+    std::pmr::monotonic_buffer_resource arena;
+    ZoneStore store(&arena);
+
+    DBM D = interval(12, 1, 5);
+    BOOST_CHECK(store.insert(7, std::move(D)));
+    BOOST_CHECK(store.get_allocator().resource() == &arena);
+    BOOST_CHECK(store.zones(7)[0].get_allocator().resource() == &arena);
+}
@@ -303,3 +303,37 @@ BOOST_AUTO_TEST_CASE(comp_test_14) {
     BOOST_CHECK(!(a <= b));
     BOOST_CHECK(a >= b);
 }
+
+BOOST_AUTO_TEST_CASE(raw_test_1) {
+    auto a = bound_t::strict(-7);
+    auto b = bound_t::non_strict(-7);
+    auto c = bound_t::strict(-6);
+
+    BOOST_CHECK(a.get_raw() < b.get_raw());
+    BOOST_CHECK(b.get_raw() < c.get_raw());
+    BOOST_CHECK(c.get_raw() < bound_t::inf().get_raw());
+    BOOST_CHECK(bound_t::from_raw(b.get_raw()) == b);
+    BOOST_CHECK(b.get_bound() == -7 && b.is_non_strict());
+    BOOST_CHECK(a.get_bound() == -7 && a.is_strict());
+}
+
+BOOST_AUTO_TEST_CASE(raw_add_test_1) {
+    BOOST_CHECK(bound_t::strict(-3) + bound_t::strict(5) == bound_t::strict(2));
+    BOOST_CHECK(bound_t::non_strict(-3) + bound_t::strict(5) == bound_t::strict(2));
+    BOOST_CHECK(bound_t::non_strict(-3) + bound_t::non_strict(-5) == bound_t::non_strict(-8));
+    BOOST_CHECK(bound_t::inf() + bound_t::non_strict(-5) == bound_t::inf());
+    BOOST_CHECK(bound_t::inf() + 10 == bound_t::inf());
+    BOOST_CHECK(bound_t::strict(-3) + 10 == bound_t::strict(7));
+    BOOST_CHECK(bound_t::non_strict(-3) - 10 == bound_t::non_strict(-13));
+    BOOST_CHECK(bound_t::strict(-3) * -1 == bound_t::strict(3));
+}
+
+BOOST_AUTO_TEST_CASE(range_test_1) {
+    const val_t max = bound_t::INF_VALUE - 1;
+    BOOST_CHECK(bound_t::strict(bound_t::INF_VALUE) == bound_t::inf());
+    BOOST_CHECK(bound_t::non_strict(max) < bound_t::inf());
+    BOOST_CHECK(bound_t::non_strict(max).get_bound() == max);
+    BOOST_CHECK(bound_t::strict(-bound_t::INF_VALUE) < bound_t::non_strict(-max));
+    BOOST_CHECK(bound_t::non_strict(max / 2) + bound_t::strict(max / 2) == bound_t::strict(max));
+    BOOST_CHECK(bound_t::strict(-max) + bound_t::non_strict(max) == bound_t::lt_zero());
+}
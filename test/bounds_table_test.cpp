@@ -25,6 +25,117 @@
 #include <boost/test/unit_test.hpp>
 #include "pardibaal/DBM.h"
 
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <memory_resource>
+
 using namespace pardibaal;
 
-BOOST_AUTO_TEST_CASE(dummy) {}
\ No newline at end of file
+BOOST_AUTO_TEST_CASE(dummy) {}
+
+BOOST_AUTO_TEST_CASE(inline_copy_test_1) {
+    for (dim_t n : {dim_t(3), std::max<dim_t>(bounds_table_t::INLINE_DIMENSION, 2), bounds_table_t::INLINE_DIMENSION + 3}) {
+        bounds_table_t a(n);
+        BOOST_CHECK(a.is_inline() == (n <= bounds_table_t::INLINE_DIMENSION));
+
+        for (dim_t i = 0; i < n; ++i)
+            for (dim_t j = 0; j < n; ++j)
+                a.set(i, j, bound_t::non_strict(i * n + j));
+
+        bounds_table_t b(a);
+        bounds_table_t c(1);
+        c = a;
+        b.set(0, 1, bound_t::inf());
+
+        BOOST_CHECK(a.at(0, 1) == bound_t::non_strict(1));
+        for (dim_t i = 0; i < n; ++i)
+            for (dim_t j = 0; j < n; ++j)
+                BOOST_CHECK(c.at(i, j) == bound_t::non_strict(i * n + j));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(inline_move_test_1) {
+    for (dim_t n : {dim_t(3), bounds_table_t::INLINE_DIMENSION + 3}) {
+        bounds_table_t a(n);
+        a.set(n - 1, 0, bound_t::strict(7));
+
+        bounds_table_t b(std::move(a));
+        BOOST_CHECK(b.number_of_clocks() == n);
+        BOOST_CHECK(b.at(n - 1, 0) == bound_t::strict(7));
+
+        bounds_table_t c(2);
+        c = std::move(b);
+        BOOST_CHECK(c.number_of_clocks() == n);
+        BOOST_CHECK(c.at(n - 1, 0) == bound_t::strict(7));
+        BOOST_CHECK(c.at(0, 0) == bound_t::le_zero());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(copy_on_write_test_1) {
+    const dim_t n = bounds_table_t::INLINE_DIMENSION + 1;
+    bounds_table_t a(n);
+    a.set(1, 0, bound_t::non_strict(4));
+
+    bounds_table_t b(a);
+    BOOST_CHECK(a.is_shared() && b.is_shared());
+    BOOST_CHECK(std::as_const(a).row(0) == std::as_const(b).row(0));
+
+    b.set(1, 0, bound_t::strict(2));
+    BOOST_CHECK(not a.is_shared() && not b.is_shared());
+    BOOST_CHECK(a.at(1, 0) == bound_t::non_strict(4));
+    BOOST_CHECK(b.at(1, 0) == bound_t::strict(2));
+}
+
+BOOST_AUTO_TEST_CASE(copy_on_write_test_2) {
+    const dim_t n = bounds_table_t::INLINE_DIMENSION + 1;
+    std::pmr::monotonic_buffer_resource arena;
+    bounds_table_t a(n, &arena);
+
+    // Tables using different memory resources never share bounds
+    bounds_table_t b(a);
+    BOOST_CHECK(not a.is_shared() && not b.is_shared());
+
+    bounds_table_t c(a, &arena);
+    BOOST_CHECK(a.is_shared() && c.is_shared());
+}
+
+BOOST_AUTO_TEST_CASE(hash_test_1) {
+    for (dim_t n : {dim_t(3), dim_t(bounds_table_t::INLINE_DIMENSION + 3)}) {
+        bounds_table_t a(n);
+        for (dim_t i = 0; i < n; ++i)
+            for (dim_t j = 0; j < n; ++j)
+                a.set(i, j, bound_t::non_strict(i * n + j));
+
+        // The vectorised hash matches the sum of the terms
+        uint64_t expected = 0;
+        for (dim_t c = 0; c < n * n; ++c)
+            expected += hash_term(c, bound_t::non_strict(c));
+        BOOST_CHECK_EQUAL(a.hash(), expected);
+
+        // Updated by set(), and copied along with the bounds
+        a.set(1, 2, bound_t::strict(-3));
+        bounds_table_t b = a;
+        BOOST_CHECK_EQUAL(a.hash(), hash_bounds(std::as_const(a).row(0), n * n));
+        BOOST_CHECK_EQUAL(b.hash(), a.hash());
+
+        // Writes through row() are seen by the next hash
+        a.row(2)[0] = bound_t::inf();
+        BOOST_CHECK_EQUAL(a.hash(), hash_bounds(std::as_const(a).row(0), n * n));
+        BOOST_CHECK(a.hash() != b.hash());
+
+        a.row(2)[0] = b.at(2, 0);
+        BOOST_CHECK_EQUAL(a.hash(), b.hash());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hash_view_test_1) {
+    std::vector<bound_t> bounds(9, bound_t::le_zero());
+    bounds_table_t view(bounds.data(), 3);
+    const uint64_t h = view.hash();
+
+    // The caller may write to the bounds of a view, so its hash is recomputed
+    bounds[4] = bound_t::strict(7);
+    BOOST_CHECK(view.hash() != h);
+    BOOST_CHECK_EQUAL(view.hash(), hash_bounds(bounds.data(), 9));
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright Thomas M. Grosen
+ * Created on 17/10/2026.
+ */
+
+/*
+ * This file is part of PARDIBAAL
+ *
+ * PARDIBAAL is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PARDIBAAL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with PARDIBAAL.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#define BOOST_TEST_MODULE PARDIBAAL
+
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+#include "pardibaal/extrapolation_t.h"
+#include "pardibaal/DBMView.h"
+#include "pardibaal/Federation.h"
+#include "errors.h"
+
+using namespace pardibaal;
+
+namespace {
+    // A random non-empty zone with clocks in [0, 30]
+    DBM random_zone(dim_t dim, std::mt19937& rng) {
+        std::uniform_int_distribution<val_t> value(0, 30), clock(1, dim - 1);
+        DBM D = DBM::unconstrained(dim);
+        std::vector<val_t> point(dim, 0);
+        for (dim_t i = 1; i < dim; ++i) point[i] = value(rng);
+
+        for (dim_t n = 0; n < dim * 2; ++n) {
+            dim_t i = clock(rng), j = rng() % dim;
+            if (i == j) continue;
+            if (rng() % 2) std::swap(i, j);
+            D.restrict(i, j, bound_t::non_strict(point[i] - point[j] + val_t(rng() % 4)));
+        }
+        D.close();
+        return D;
+    }
+
+    std::vector<val_t> random_constants(dim_t dim, std::mt19937& rng) {
+        std::uniform_int_distribution<val_t> value(-5, 25);
+        std::vector<val_t> constants(dim, 0);
+        for (dim_t i = 1; i < dim; ++i) constants[i] = value(rng);
+        return constants;
+    }
+
+    void check_equal_bounds(const DBM& A, const DBM& B) {
+        BOOST_CHECK_EQUAL(A.is_empty(), B.is_empty());
+        for (dim_t i = 0; i < A.dimension(); ++i)
+            for (dim_t j = 0; j < A.dimension(); ++j)
+                BOOST_CHECK(A.at(i, j) == B.at(i, j));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(extrapolation_m_test_1) {
+    std::mt19937 rng(1);
+    for (dim_t dim : {dim_t(3), dim_t(12)}) {
+        for (int n = 0; n < 20; ++n) {
+            auto ceiling = random_constants(dim, rng);
+            auto m = extrapolation_t::m(ceiling);
+            auto m_diagonal = extrapolation_t::m_diagonal(ceiling);
+            BOOST_CHECK_EQUAL(m.dimension(), dim);
+            BOOST_CHECK(m_diagonal.kind() == extrapolation_t::M_DIAGONAL);
+
+            DBM D = random_zone(dim, rng), E = D, F = D, G = D;
+            D.extrapolate(ceiling);
+            E.extrapolate(m);
+            check_equal_bounds(D, E);
+
+            F.extrapolate_diagonal(ceiling);
+            G.extrapolate(m_diagonal);
+            check_equal_bounds(F, G);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(extrapolation_lu_test_1) {
+    std::mt19937 rng(2);
+    for (dim_t dim : {dim_t(3), dim_t(12)}) {
+        for (int n = 0; n < 20; ++n) {
+            auto lower = random_constants(dim, rng), upper = random_constants(dim, rng);
+            auto lu = extrapolation_t::lu(lower, upper);
+            auto lu_diagonal = extrapolation_t::lu_diagonal(lower, upper);
+
+            DBM D = random_zone(dim, rng), E = D, F = D, G = D;
+            D.extrapolate_lu(lower, upper);
+            E.extrapolate(lu);
+            check_equal_bounds(D, E);
+
+            F.extrapolate_lu_diagonal(lower, upper);
+            G.extrapolate(lu_diagonal);
+            check_equal_bounds(F, G);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(extrapolation_federation_test_1) {
+    std::mt19937 rng(3);
+    const dim_t dim = 6;
+    auto lower = random_constants(dim, rng), upper = random_constants(dim, rng);
+    auto lu_diagonal = extrapolation_t::lu_diagonal(lower, upper);
+
+    Federation fed(random_zone(dim, rng));
+    for (int n = 0; n < 4; ++n) fed.add(random_zone(dim, rng));
+
+    Federation expected = fed;
+    expected.extrapolate_lu_diagonal(lower, upper);
+    fed.extrapolate(lu_diagonal);
+
+    BOOST_CHECK(fed.is_equal(expected));
+    BOOST_CHECK_EQUAL(fed.size(), expected.size());
+}
+
+BOOST_AUTO_TEST_CASE(extrapolation_view_test_1) {
+    std::mt19937 rng(4);
+    const dim_t dim = 5;
+    auto ceiling = random_constants(dim, rng);
+    DBM D = random_zone(dim, rng);
+
+    std::vector<bound_t> buffer(dim * dim);
+    for (dim_t i = 0; i < dim; ++i)
+        for (dim_t j = 0; j < dim; ++j)
+            buffer[i * dim + j] = D.at(i, j);
+
+    DBMView view(buffer.data(), dim);
+    view.extrapolate(extrapolation_t::m_diagonal(ceiling));
+    D.extrapolate_diagonal(ceiling);
+    check_equal_bounds(view.dbm(), D);
+}
+
+#ifndef NEXCEPTIONS
+BOOST_AUTO_TEST_CASE(extrapolation_dimension_test_1) {
+    DBM D(4);
+    BOOST_CHECK_THROW(D.extrapolate(extrapolation_t::m({0, 1, 2})), base_error);
+    BOOST_CHECK_THROW(extrapolation_t::lu({0, 1, 2}, {0, 1}), base_error);
+}
+#endif